@@ -2,25 +2,32 @@
 
 
 #include "Actors/TrickyAnnotationActor.h"
+#include "Components/TrickyAnnotationBackgroundComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/TextRenderComponent.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Materials/MaterialInterface.h"
 #include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Subsystems/TrickyAnnotationSubsystem.h"
+#include "TrickyTextMetricsCache.h"
+#include "TrickyUtilitiesStats.h"
 
 
 ATrickyAnnotationActor::ATrickyAnnotationActor()
 {
+	LLM_SCOPE_BYTAG(TrickyUtilities_Annotations);
+
 	PrimaryActorTick.bCanEverTick = false;
 	SetCanBeDamaged(false);
 
 	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
 
-	FrontMeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("FrontMesh"));
+	FrontMeshComponent = CreateDefaultSubobject<UTrickyAnnotationBackgroundComponent>(TEXT("FrontMesh"));
 	FrontMeshComponent->SetupAttachment(GetRootComponent());
 	SetupComponent(FrontMeshComponent);
 
-	BackMeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("BackMesh"));
+	BackMeshComponent = CreateDefaultSubobject<UTrickyAnnotationBackgroundComponent>(TEXT("BackMesh"));
 	BackMeshComponent->SetupAttachment(GetRootComponent());
 	SetupComponent(BackMeshComponent);
 
@@ -85,32 +92,113 @@ ATrickyAnnotationActor::ATrickyAnnotationActor()
 
 void ATrickyAnnotationActor::OnConstruction(const FTransform& Transform)
 {
+	LLM_SCOPE_BYTAG(TrickyUtilities_Annotations);
+
 	Super::OnConstruction(Transform);
 
-	UpdateTextProperties(FrontTextComponent,
-	                     AnnotationText,
-	                     TextSize,
-	                     TextColor,
-	                     VerticalAlignment,
-	                     HorizontalAlignment,
-	                     TextMaterial);
-	UpdateTextHorizontalPosition(FrontTextComponent, false);
-	UpdateTextVerticalPosition(FrontTextComponent);
-
-	UpdateTextProperties(BackTextComponent,
-	                     AnnotationText,
-	                     TextSize,
-	                     TextColor,
-	                     VerticalAlignment,
-	                     HorizontalAlignment,
-	                     TextMaterial);
-	UpdateTextHorizontalPosition(BackTextComponent, true);
-	UpdateTextVerticalPosition(BackTextComponent);
-
-	UpdateBackgroundSize(FrontMeshComponent);
-	UpdateBackgroundSize(BackMeshComponent);
+	// Text layout is the expensive part, so it's measured again only when the text or its size changed.
+	const bool bLayoutChanged = !bHasAppliedProperties
+		|| TextSize != AppliedTextSize
+		|| !AnnotationText.ToString().Equals(AppliedText, ESearchCase::CaseSensitive);
+	const bool bAlignmentChanged = !bHasAppliedProperties
+		|| VerticalAlignment != AppliedVerticalAlignment
+		|| HorizontalAlignment != AppliedHorizontalAlignment;
+	const bool bAppearanceChanged = !bHasAppliedProperties
+		|| TextColor != AppliedTextColor
+		|| AppliedTextMaterial.Get() != TextMaterial;
+
+	if (bLayoutChanged || bAlignmentChanged || bAppearanceChanged)
+	{
+		UpdateTextProperties(FrontTextComponent,
+		                     AnnotationText,
+		                     TextSize,
+		                     TextColor,
+		                     VerticalAlignment,
+		                     HorizontalAlignment,
+		                     TextMaterial);
+		UpdateTextProperties(BackTextComponent,
+		                     AnnotationText,
+		                     TextSize,
+		                     TextColor,
+		                     VerticalAlignment,
+		                     HorizontalAlignment,
+		                     TextMaterial);
+	}
+
+	if (bLayoutChanged || bAlignmentChanged)
+	{
+		UpdateTextHorizontalPosition(FrontTextComponent, false);
+		UpdateTextVerticalPosition(FrontTextComponent);
+		UpdateTextHorizontalPosition(BackTextComponent, true);
+		UpdateTextVerticalPosition(BackTextComponent);
+	}
+
+	if (bLayoutChanged)
+	{
+		UpdateBackgroundSize(FrontMeshComponent);
+		UpdateBackgroundSize(BackMeshComponent);
+	}
+
+	// Also marks the backgrounds dirty and picks up mesh or material changes of the background components.
+	UpdateBackgroundsBatching();
+
+	StoreAppliedProperties();
+}
+
+void ATrickyAnnotationActor::PreRegisterAllComponents()
+{
+	Super::PreRegisterAllComponents();
+
+	UpdateBackgroundsBatching();
+}
+
+void ATrickyAnnotationActor::PostRegisterAllComponents()
+{
+	Super::PostRegisterAllComponents();
+
+	USceneComponent* Root = GetRootComponent();
+
+	if (!IsValid(Root))
+	{
+		return;
+	}
+
+	// Backgrounds rendered by the subsystem have to follow the actor.
+	Root->TransformUpdated.Remove(TransformUpdatedHandle);
+	TransformUpdatedHandle = Root->TransformUpdated.AddUObject(this, &ATrickyAnnotationActor::OnRootTransformUpdated);
+}
+
+void ATrickyAnnotationActor::PostUnregisterAllComponents()
+{
+	if (UTrickyAnnotationSubsystem* Subsystem = AnnotationSubsystem.Get())
+	{
+		Subsystem->UnregisterAnnotation(this);
+	}
+
+	if (USceneComponent* Root = GetRootComponent())
+	{
+		Root->TransformUpdated.Remove(TransformUpdatedHandle);
+	}
+
+	TransformUpdatedHandle.Reset();
+
+	Super::PostUnregisterAllComponents();
+}
+
+void ATrickyAnnotationActor::SetActorHiddenInGame(bool bNewHidden)
+{
+	Super::SetActorHiddenInGame(bNewHidden);
+	MarkBackgroundsDirty();
 }
 
+#if WITH_EDITOR
+void ATrickyAnnotationActor::SetIsTemporarilyHiddenInEditor(bool bIsHidden)
+{
+	Super::SetIsTemporarilyHiddenInEditor(bIsHidden);
+	MarkBackgroundsDirty();
+}
+#endif
+
 void ATrickyAnnotationActor::SetAnnotationText(const FText& NewText)
 {
 	AnnotationText = NewText;
@@ -125,6 +213,31 @@ void ATrickyAnnotationActor::SetTextColor(const FColor& NewColor)
 	BackTextComponent->SetTextRenderColor(TextColor);
 }
 
+void ATrickyAnnotationActor::GetBackgroundTransforms(TArray<FTransform>& OutTransforms) const
+{
+	bool bIsHidden = IsHidden();
+
+#if WITH_EDITOR
+	const UWorld* World = GetWorld();
+
+	if (IsValid(World) && !World->IsGameWorld())
+	{
+		bIsHidden = IsHiddenEd();
+	}
+#endif
+
+	for (const UStaticMeshComponent* Component : {FrontMeshComponent.Get(), BackMeshComponent.Get()})
+	{
+		if (bIsHidden || !IsValid(Component))
+		{
+			OutTransforms.Emplace(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+			continue;
+		}
+
+		OutTransforms.Emplace(Component->GetComponentTransform());
+	}
+}
+
 void ATrickyAnnotationActor::UpdateTextProperties(UTextRenderComponent* Component,
                                                   const FText& Text,
                                                   const int32 Size,
@@ -158,7 +271,7 @@ void ATrickyAnnotationActor::UpdateBackgroundSize(UStaticMeshComponent* Componen
 		return;
 	}
 
-	const FVector TextLocalSize = FrontTextComponent->GetTextLocalSize();
+	const FVector TextLocalSize = FTrickyTextMetricsCache::Get().GetTextLocalSize(*FrontTextComponent);
 	FVector NewScale = FVector::OneVector;
 	NewScale.X = (TextLocalSize.Z / 100.f) + TextOffset;
 	NewScale.Y = (TextLocalSize.Y / 100.f) + TextOffset;
@@ -190,7 +303,7 @@ void ATrickyAnnotationActor::UpdateTextHorizontalPosition(UTextRenderComponent*
 	}
 
 	FVector NewLocation = Component->GetRelativeLocation();
-	NewLocation.Y = CurrentDisplacementFactor * Component->GetTextLocalSize().Y;
+	NewLocation.Y = CurrentDisplacementFactor * FTrickyTextMetricsCache::Get().GetTextLocalSize(*Component).Y;
 
 	if (bNegate)
 	{
@@ -225,10 +338,75 @@ void ATrickyAnnotationActor::UpdateTextVerticalPosition(UTextRenderComponent* Co
 	}
 
 	FVector NewLocation = Component->GetRelativeLocation();
-	NewLocation.Z = CurrentDisplacementFactor * Component->GetTextLocalSize().Z;
+	NewLocation.Z = CurrentDisplacementFactor * FTrickyTextMetricsCache::Get().GetTextLocalSize(*Component).Z;
 	Component->SetRelativeLocation(NewLocation);
 }
 
+void ATrickyAnnotationActor::StoreAppliedProperties()
+{
+	bHasAppliedProperties = true;
+	AppliedText = AnnotationText.ToString();
+	AppliedTextSize = TextSize;
+	AppliedTextColor = TextColor;
+	AppliedVerticalAlignment = VerticalAlignment;
+	AppliedHorizontalAlignment = HorizontalAlignment;
+	AppliedTextMaterial = TextMaterial;
+}
+
+bool ATrickyAnnotationActor::GetBackgroundMeshAndMaterial(UStaticMesh*& OutMesh,
+                                                          UMaterialInterface*& OutMaterial) const
+{
+	if (!IsValid(FrontMeshComponent) || !IsValid(BackMeshComponent))
+	{
+		return false;
+	}
+
+	OutMesh = FrontMeshComponent->GetStaticMesh();
+	OutMaterial = FrontMeshComponent->GetMaterial(0);
+
+	return OutMesh != nullptr
+		&& OutMesh == BackMeshComponent->GetStaticMesh()
+		&& OutMaterial == BackMeshComponent->GetMaterial(0);
+}
+
+UStaticMeshComponent* ATrickyAnnotationActor::GetBackgroundComponent(const int32 Index) const
+{
+	return Index == 0 ? FrontMeshComponent.Get() : BackMeshComponent.Get();
+}
+
+void ATrickyAnnotationActor::UpdateBackgroundsBatching()
+{
+	UTrickyAnnotationSubsystem* Subsystem = UTrickyAnnotationSubsystem::GetBatchingSubsystem(GetWorld());
+	const bool bIsBatched = IsValid(Subsystem) && Subsystem->RegisterAnnotation(this);
+	AnnotationSubsystem = bIsBatched ? Subsystem : nullptr;
+
+	// Batched background components skip creating render proxies instead of changing their saved visibility.
+	if (IsValid(FrontMeshComponent))
+	{
+		FrontMeshComponent->SetRenderedByBatch(bIsBatched);
+	}
+
+	if (IsValid(BackMeshComponent))
+	{
+		BackMeshComponent->SetRenderedByBatch(bIsBatched);
+	}
+}
+
+void ATrickyAnnotationActor::MarkBackgroundsDirty()
+{
+	if (UTrickyAnnotationSubsystem* Subsystem = AnnotationSubsystem.Get())
+	{
+		Subsystem->MarkAnnotationDirty(this);
+	}
+}
+
+void ATrickyAnnotationActor::OnRootTransformUpdated(USceneComponent* UpdatedComponent,
+                                                    EUpdateTransformFlags UpdateTransformFlags,
+                                                    ETeleportType Teleport)
+{
+	MarkBackgroundsDirty();
+}
+
 void ATrickyAnnotationActor::SetupComponent(UPrimitiveComponent* Component) const
 {
 	if (!IsValid(Component))
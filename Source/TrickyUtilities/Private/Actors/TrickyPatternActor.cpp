@@ -0,0 +1,129 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+
+#include "Actors/TrickyPatternActor.h"
+
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "TrickyUtilitiesStats.h"
+
+
+ATrickyPatternActor::ATrickyPatternActor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+	InstancedMeshComponent = CreateDefaultSubobject<UHierarchicalInstancedStaticMeshComponent>(TEXT("InstancedMesh"));
+	InstancedMeshComponent->SetupAttachment(GetRootComponent());
+}
+
+void ATrickyPatternActor::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	RegeneratePattern();
+}
+
+#if WITH_EDITOR
+void ATrickyPatternActor::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	// Slider drags regenerate the pattern on every step, so the tree is built only once the value is set.
+	const bool bIsInteractive = PropertyChangedEvent.ChangeType == EPropertyChangeType::Interactive;
+
+	if (IsValid(InstancedMeshComponent))
+	{
+		InstancedMeshComponent->bAutoRebuildTreeOnInstanceChanges = !bIsInteractive;
+	}
+
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (!bIsInteractive && IsValid(InstancedMeshComponent))
+	{
+		InstancedMeshComponent->BuildTreeIfOutdated(false, false);
+	}
+}
+#endif
+
+void ATrickyPatternActor::SetPatternSettings(const FTrickyPatternSettings& NewSettings)
+{
+	PatternSettings = NewSettings;
+	RegeneratePattern();
+}
+
+void ATrickyPatternActor::RegeneratePattern()
+{
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+
+	if (!IsValid(InstancedMeshComponent))
+	{
+		return;
+	}
+
+	TArray<FTransform> Transforms;
+	UTrickyUtilityLibrary::CalculatePatternTransforms(FTransform::Identity, PatternSettings, Transforms);
+	ApplyInstanceTransforms(Transforms);
+}
+
+void ATrickyPatternActor::ApplyInstanceTransforms(const TArray<FTransform>& NewTransforms)
+{
+	const int32 InstancesAmount = InstancedMeshComponent->GetInstanceCount();
+
+	if (InstancesAmount != InstanceTransforms.Num())
+	{
+		// Instances were changed outside of this actor or weren't applied yet, so nothing can be reused.
+		InstancedMeshComponent->ClearInstances();
+		InstancedMeshComponent->AddInstances(NewTransforms, false);
+		InstanceTransforms = NewTransforms;
+		return;
+	}
+
+	const int32 SharedAmount = FMath::Min(InstancesAmount, NewTransforms.Num());
+	TArray<FTransform> ChangedTransforms;
+	bool bUpdatedInstances = false;
+
+	for (int32 i = 0; i < SharedAmount;)
+	{
+		if (InstanceTransforms[i].Equals(NewTransforms[i]))
+		{
+			++i;
+			continue;
+		}
+
+		const int32 RangeStart = i;
+		ChangedTransforms.Reset();
+
+		for (; i < SharedAmount && !InstanceTransforms[i].Equals(NewTransforms[i]); ++i)
+		{
+			ChangedTransforms.Emplace(NewTransforms[i]);
+		}
+
+		InstancedMeshComponent->BatchUpdateInstancesTransforms(RangeStart, ChangedTransforms, false, false);
+		bUpdatedInstances = true;
+	}
+
+	if (InstancesAmount > NewTransforms.Num())
+	{
+		TArray<int32> RemovedInstances;
+		RemovedInstances.Reserve(InstancesAmount - NewTransforms.Num());
+
+		for (int32 i = InstancesAmount - 1; i >= NewTransforms.Num(); --i)
+		{
+			RemovedInstances.Emplace(i);
+		}
+
+		InstancedMeshComponent->RemoveInstances(RemovedInstances);
+	}
+	else if (InstancesAmount < NewTransforms.Num())
+	{
+		const TArray<FTransform> AddedTransforms(NewTransforms.GetData() + InstancesAmount,
+		                                         NewTransforms.Num() - InstancesAmount);
+		InstancedMeshComponent->AddInstances(AddedTransforms, false);
+	}
+
+	if (bUpdatedInstances)
+	{
+		InstancedMeshComponent->MarkRenderStateDirty();
+	}
+
+	InstanceTransforms = NewTransforms;
+}
@@ -3,12 +3,150 @@
 
 #include "Actors/TrickySplineActor.h"
 
+#include "Async/ParallelFor.h"
 #include "Components/SplineComponent.h"
 
 
 ATrickySplineActor::ATrickySplineActor()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 
 	SplineComponent = CreateDefaultSubobject<USplineComponent>(TEXT("SplineComponent"));
 }
+
+void ATrickySplineActor::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	// The table is in local space, so it's built on the first query instead of on every move of the actor.
+	MarkLookupTableDirty();
+}
+
+void ATrickySplineActor::MarkLookupTableDirty()
+{
+	bIsLookupTableDirty = true;
+}
+
+void ATrickySplineActor::RebuildLookupTable()
+{
+	bIsLookupTableDirty = false;
+	bIsSegmentTreeDirty = true;
+
+	if (!IsValid(SplineComponent))
+	{
+		LookupTable.Reset();
+		return;
+	}
+
+	LookupTable.Build(SplineComponent->SplineCurves, SplineComponent->DefaultUpVector, LookupTableStep);
+}
+
+const FTrickySplineLookupTable& ATrickySplineActor::GetLookupTable()
+{
+	if (bIsLookupTableDirty)
+	{
+		RebuildLookupTable();
+	}
+
+	return LookupTable;
+}
+
+FVector ATrickySplineActor::GetLocationAtDistance(const float Distance, const bool bUseLocalSpace)
+{
+	const FVector Location = GetLookupTable().GetLocationAtDistance(Distance);
+	return bUseLocalSpace ? Location : SplineComponent->GetComponentTransform().TransformPosition(Location);
+}
+
+FVector ATrickySplineActor::GetDirectionAtDistance(const float Distance, const bool bUseLocalSpace)
+{
+	const FVector Direction = GetLookupTable().GetDirectionAtDistance(Distance);
+	return bUseLocalSpace ? Direction : SplineComponent->GetComponentTransform().TransformVectorNoScale(Direction);
+}
+
+FVector ATrickySplineActor::GetUpVectorAtDistance(const float Distance, const bool bUseLocalSpace)
+{
+	const FVector UpVector = GetLookupTable().GetUpVectorAtDistance(Distance);
+	return bUseLocalSpace ? UpVector : SplineComponent->GetComponentTransform().TransformVectorNoScale(UpVector);
+}
+
+float ATrickySplineActor::GetRollAtDistance(const float Distance, const bool bUseLocalSpace)
+{
+	if (bUseLocalSpace)
+	{
+		return GetLookupTable().GetRollAtDistance(Distance);
+	}
+
+	return GetTransformAtDistance(Distance, false).Rotator().Roll;
+}
+
+FTransform ATrickySplineActor::GetTransformAtDistance(const float Distance, const bool bUseLocalSpace)
+{
+	const FTransform Transform = GetLookupTable().GetTransformAtDistance(Distance);
+	return bUseLocalSpace ? Transform : Transform * SplineComponent->GetComponentTransform();
+}
+
+const FTrickySplineSegmentTree& ATrickySplineActor::GetSegmentTree()
+{
+	const FTrickySplineLookupTable& CurrentLookupTable = GetLookupTable();
+
+	if (bIsSegmentTreeDirty)
+	{
+		bIsSegmentTreeDirty = false;
+		SegmentTree.Build(CurrentLookupTable);
+	}
+
+	return SegmentTree;
+}
+
+void ATrickySplineActor::FindClosestPointToLocation(const FVector& Location,
+                                                    const bool bUseLocalSpace,
+                                                    float& OutDistance,
+                                                    FVector& OutLocation)
+{
+	const FTransform& ComponentTransform = SplineComponent->GetComponentTransform();
+	const FVector LocalLocation = bUseLocalSpace ? Location : ComponentTransform.InverseTransformPosition(Location);
+
+	OutDistance = 0.f;
+	OutLocation = FVector::ZeroVector;
+	GetSegmentTree().FindClosestPoint(LocalLocation, OutDistance, OutLocation);
+
+	if (!bUseLocalSpace)
+	{
+		OutLocation = ComponentTransform.TransformPosition(OutLocation);
+	}
+}
+
+void ATrickySplineActor::FindClosestPointsToLocations(const TArray<FVector>& Locations,
+                                                      const bool bUseLocalSpace,
+                                                      TArray<float>& OutDistances,
+                                                      TArray<FVector>& OutLocations)
+{
+	constexpr int32 QueriesChunkSize = 256;
+
+	// The tree is built on the game thread before the workers start reading it.
+	const FTrickySplineSegmentTree& Tree = GetSegmentTree();
+	const FTransform& ComponentTransform = SplineComponent->GetComponentTransform();
+
+	OutDistances.SetNumUninitialized(Locations.Num());
+	OutLocations.SetNumUninitialized(Locations.Num());
+
+	const int32 ChunksAmount = FMath::DivideAndRoundUp(Locations.Num(), QueriesChunkSize);
+	ParallelFor(ChunksAmount, [&](const int32 ChunkIndex)
+	{
+		const int32 StartIndex = ChunkIndex * QueriesChunkSize;
+		const int32 EndIndex = FMath::Min(StartIndex + QueriesChunkSize, Locations.Num());
+
+		for (int32 i = StartIndex; i < EndIndex; ++i)
+		{
+			const FVector LocalLocation = bUseLocalSpace
+				                              ? Locations[i]
+				                              : ComponentTransform.InverseTransformPosition(Locations[i]);
+			float Distance = 0.f;
+			FVector ClosestLocation = FVector::ZeroVector;
+			Tree.FindClosestPoint(LocalLocation, Distance, ClosestLocation);
+
+			OutDistances[i] = Distance;
+			OutLocations[i] = bUseLocalSpace ? ClosestLocation : ComponentTransform.TransformPosition(ClosestLocation);
+		}
+	});
+}
@@ -0,0 +1,753 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+
+#include "Commandlets/TrickyUtilitiesBenchmarkCommandlet.h"
+
+#include "TrickyPatternCache.h"
+#include "TrickyUtilityLibrary.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Components/SplineComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogTrickyUtilitiesBenchmark, Log, All);
+
+namespace
+{
+	/**
+	 * Forwards all allocations to the wrapped allocator and counts them.
+	 * Installed as GMalloc only for the counting call of every case, so it doesn't slow down the timed calls.
+	 */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInnerMalloc)
+			: InnerMalloc(InInnerMalloc)
+		{
+		}
+
+		/**
+		 * @param InCountedThreadId If not 0, only allocations made by the thread with this id are counted.
+		 */
+		void ResetCounters(const uint32 InCountedThreadId = 0)
+		{
+			CountedThreadId = InCountedThreadId;
+			AllocationsAmount = 0;
+			AllocatedBytes = 0;
+			LiveBytes = 0;
+			PeakLiveBytes = 0;
+		}
+
+		int64 GetAllocationsAmount() const { return AllocationsAmount; }
+
+		int64 GetAllocatedBytes() const { return AllocatedBytes; }
+
+		int64 GetPeakLiveBytes() const { return PeakLiveBytes; }
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			void* Result = InnerMalloc->Malloc(Count, Alignment);
+			OnAllocated(Result, Count);
+			return Result;
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			OnFreed(Original);
+			void* Result = InnerMalloc->Realloc(Original, Count, Alignment);
+			OnAllocated(Result, Count);
+			return Result;
+		}
+
+		virtual void Free(void* Original) override
+		{
+			OnFreed(Original);
+			InnerMalloc->Free(Original);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return InnerMalloc->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return InnerMalloc->QuantizeSize(Count, Alignment);
+		}
+
+		virtual void Trim(bool bTrimThreadCaches) override
+		{
+			InnerMalloc->Trim(bTrimThreadCaches);
+		}
+
+		virtual void SetupTLSCachesOnCurrentThread() override
+		{
+			InnerMalloc->SetupTLSCachesOnCurrentThread();
+		}
+
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+		{
+			InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return InnerMalloc->IsInternallyThreadSafe();
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return TEXT("TrickyUtilitiesCountingMalloc");
+		}
+
+	private:
+		FMalloc* InnerMalloc = nullptr;
+
+		std::atomic<int64> AllocationsAmount = 0;
+
+		std::atomic<int64> AllocatedBytes = 0;
+
+		/** Bytes allocated and not freed since the last reset. Blocks allocated before it can make it negative. */
+		std::atomic<int64> LiveBytes = 0;
+
+		std::atomic<int64> PeakLiveBytes = 0;
+
+		std::atomic<uint32> CountedThreadId = 0;
+
+		bool ShouldCount() const
+		{
+			const uint32 ThreadId = CountedThreadId;
+			return ThreadId == 0 || ThreadId == FPlatformTLS::GetCurrentThreadId();
+		}
+
+		void OnAllocated(void* Pointer, const SIZE_T Count)
+		{
+			if (Pointer == nullptr || !ShouldCount())
+			{
+				return;
+			}
+
+			SIZE_T Size = Count;
+			InnerMalloc->GetAllocationSize(Pointer, Size);
+
+			++AllocationsAmount;
+			AllocatedBytes += static_cast<int64>(Count);
+			const int64 NewLiveBytes = LiveBytes += static_cast<int64>(Size);
+			int64 CurrentPeak = PeakLiveBytes;
+
+			while (NewLiveBytes > CurrentPeak && !PeakLiveBytes.compare_exchange_weak(CurrentPeak, NewLiveBytes))
+			{
+			}
+		}
+
+		void OnFreed(void* Pointer)
+		{
+			SIZE_T Size = 0;
+
+			if (Pointer != nullptr && ShouldCount() && InnerMalloc->GetAllocationSize(Pointer, Size))
+			{
+				LiveBytes -= static_cast<int64>(Size);
+			}
+		}
+	};
+
+	struct FBenchmarkResult
+	{
+		FString Name;
+
+		int32 RequestedPoints = 0;
+
+		int32 PointsAmount = 0;
+
+		int32 Iterations = 0;
+
+		double NanosecondsPerPoint = 0.0;
+
+		double AllocationsPerCall = 0.0;
+
+		double AllocatedBytesPerCall = 0.0;
+
+		int64 PeakLiveBytes = 0;
+	};
+
+	/** Every case is repeated until it takes this long, so small sizes get stable timings. */
+	constexpr double MinCaseSeconds = 0.2;
+
+	constexpr int32 MinIterations = 3;
+
+	constexpr int32 MaxIterations = 10000;
+
+	/**
+	 * Runs the given function repeatedly and measures it.
+	 * Timing uses the regular allocator, allocations and peak memory are counted during one extra call afterwards.
+	 * Function is called as Function() and must return the amount of points it produced.
+	 */
+	template <typename FunctionType>
+	FBenchmarkResult RunBenchmarkCase(FCountingMalloc& CountingMalloc,
+	                                  const FString& Name,
+	                                  const int32 RequestedPoints,
+	                                  FunctionType&& Function)
+	{
+		FBenchmarkResult Result;
+		Result.Name = Name;
+		Result.RequestedPoints = RequestedPoints;
+
+		// A warm up run keeps one time initialization, like filling the pattern cache, out of the measurement.
+		Result.PointsAmount = Function();
+
+		double TotalSeconds = 0.0;
+
+		auto ShouldContinue = [&Result, &TotalSeconds]
+		{
+			return Result.Iterations < MinIterations || TotalSeconds < MinCaseSeconds;
+		};
+
+		while (Result.Iterations < MaxIterations && ShouldContinue())
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Function();
+			TotalSeconds += FPlatformTime::Seconds() - StartTime;
+			++Result.Iterations;
+		}
+
+		const double PointsTotal = FMath::Max(1.0, static_cast<double>(Result.PointsAmount) * Result.Iterations);
+		Result.NanosecondsPerPoint = TotalSeconds * 1e9 / PointsTotal;
+
+		// Other threads allocating at the same time are counted too, so the counting call is kept short.
+		FMalloc* PreviousMalloc = GMalloc;
+		CountingMalloc.ResetCounters();
+		GMalloc = &CountingMalloc;
+		Function();
+		GMalloc = PreviousMalloc;
+
+		Result.AllocationsPerCall = static_cast<double>(CountingMalloc.GetAllocationsAmount());
+		Result.AllocatedBytesPerCall = static_cast<double>(CountingMalloc.GetAllocatedBytes());
+		Result.PeakLiveBytes = CountingMalloc.GetPeakLiveBytes();
+
+		UE_LOG(LogTrickyUtilitiesBenchmark,
+		       Display,
+		       TEXT("%-40s %8d points %10.2f ns/point %8.1f allocs/call %12lld peak bytes"),
+		       *Result.Name,
+		       Result.PointsAmount,
+		       Result.NanosecondsPerPoint,
+		       Result.AllocationsPerCall,
+		       Result.PeakLiveBytes);
+
+		return Result;
+	}
+
+	/** Overrides TrickyUtilities.ParallelPatternThreshold for the lifetime of the scope. */
+	class FScopedParallelPatternThreshold
+	{
+	public:
+		explicit FScopedParallelPatternThreshold(const int32 Threshold)
+			: ConsoleVariable(IConsoleManager::Get().FindConsoleVariable(TEXT("TrickyUtilities.ParallelPatternThreshold")))
+		{
+			if (ConsoleVariable != nullptr)
+			{
+				PreviousThreshold = ConsoleVariable->GetInt();
+				ConsoleVariable->Set(Threshold, ECVF_SetByCode);
+			}
+		}
+
+		~FScopedParallelPatternThreshold()
+		{
+			if (ConsoleVariable != nullptr)
+			{
+				ConsoleVariable->Set(PreviousThreshold, ECVF_SetByCode);
+			}
+		}
+
+	private:
+		IConsoleVariable* ConsoleVariable = nullptr;
+
+		int32 PreviousThreshold = 0;
+	};
+
+	/** Returns true if both arrays hold exactly the same transforms. */
+	bool AreTransformsIdentical(const TArray<FTransform>& A, const TArray<FTransform>& B)
+	{
+		if (A.Num() != B.Num())
+		{
+			return false;
+		}
+
+		for (int32 i = 0; i < A.Num(); ++i)
+		{
+			if (!A[i].Equals(B[i], 0.0))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/** Returns the amount of allocations made by the calling thread during a single Function() call. */
+	template <typename FunctionType>
+	int64 CountThreadAllocations(FCountingMalloc& CountingMalloc, FunctionType&& Function)
+	{
+		FMalloc* PreviousMalloc = GMalloc;
+		CountingMalloc.ResetCounters(FPlatformTLS::GetCurrentThreadId());
+		GMalloc = &CountingMalloc;
+		Function();
+		GMalloc = PreviousMalloc;
+		return CountingMalloc.GetAllocationsAmount();
+	}
+
+	/** Returns true for generators which combine several rings or arcs into one pattern. */
+	bool IsCompositePattern(const EPatternType PatternType)
+	{
+		switch (PatternType)
+		{
+		case EPatternType::ConcentricRings:
+		case EPatternType::DynamicConcentricRings:
+		case EPatternType::Cylinder:
+		case EPatternType::ConcentricArcs:
+		case EPatternType::DynamicConcentricArcs:
+		case EPatternType::ArcCylinder:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	/** Builds pattern settings producing roughly the given amount of points. */
+	FTrickyPatternSettings MakePatternSettings(const EPatternType PatternType, const int32 PointsAmount)
+	{
+		constexpr int32 RingsAmount = 10;
+
+		FTrickyPatternSettings Settings;
+		Settings.PatternType = PatternType;
+		Settings.Radius = 1000.f;
+		Settings.MinRadius = 100.f;
+		Settings.MaxRadius = 1000.f;
+		Settings.Height = 1000.f;
+		Settings.AngleDeg = 180.f;
+		Settings.RingsAmount = RingsAmount;
+		Settings.PointsAmount = PointsAmount;
+
+		switch (PatternType)
+		{
+		case EPatternType::Grid:
+			{
+				const int32 Size = FMath::Max(1, FMath::RoundToInt32(FMath::Sqrt(static_cast<float>(PointsAmount))));
+				Settings.GridSize = FIntVector(Size, Size, 1);
+				break;
+			}
+		case EPatternType::Cube:
+			{
+				const float CubeRoot = FMath::Pow(static_cast<float>(PointsAmount), 1.f / 3.f);
+				const int32 Size = FMath::Max(1, FMath::RoundToInt32(CubeRoot));
+				Settings.GridSize = FIntVector(Size);
+				break;
+			}
+		case EPatternType::ConcentricRings:
+		case EPatternType::Cylinder:
+		case EPatternType::ConcentricArcs:
+		case EPatternType::ArcCylinder:
+			Settings.PointsAmount = FMath::Max(1, PointsAmount / RingsAmount);
+			break;
+		case EPatternType::DynamicConcentricRings:
+		case EPatternType::DynamicConcentricArcs:
+			// Points grow with the radius from MinPoints on the inner ring up to MaxPoints on the outer one.
+			Settings.MinPoints = FMath::Max(1, PointsAmount / (RingsAmount * 5));
+			Settings.MaxPoints = FMath::Max(Settings.MinPoints, PointsAmount / 5);
+			break;
+		default:
+			break;
+		}
+
+		return Settings;
+	}
+
+	/**
+	 * The ring loop the library used before the vectorized kernel, kept as a reference:
+	 * sine and cosine for every point and a rotation built through a matrix and a rotator.
+	 */
+	void CalculateScalarRingTransforms(const FTransform& Origin,
+	                                   const int32 PointsAmount,
+	                                   const float Radius,
+	                                   const EPointDirection Direction,
+	                                   TArray<FTransform>& OutTransforms)
+	{
+		const float Theta = (2.f * PI) / PointsAmount;
+		const FVector UpVector = Origin.GetRotation().GetUpVector();
+		const FVector OriginLocation = Origin.GetLocation();
+
+		for (int32 i = 0; i < PointsAmount; ++i)
+		{
+			const float Angle = Theta * i;
+			FTransform NewTransform(FVector(Radius * FMath::Cos(Angle), Radius * FMath::Sin(Angle), 0.f));
+			NewTransform *= Origin;
+
+			const FVector DirectionToOrigin = (NewTransform.GetLocation() - OriginLocation).GetSafeNormal();
+			FRotator PointRotation = Origin.Rotator();
+
+			switch (Direction)
+			{
+			case EPointDirection::Clockwise:
+				PointRotation = FRotationMatrix::MakeFromXZ(FVector::CrossProduct(UpVector, DirectionToOrigin),
+				                                            UpVector).Rotator();
+				break;
+			case EPointDirection::CounterClockwise:
+				PointRotation = FRotationMatrix::MakeFromXZ(FVector::CrossProduct(DirectionToOrigin, UpVector),
+				                                            UpVector).Rotator();
+				break;
+			case EPointDirection::Inside:
+				PointRotation = FRotationMatrix::MakeFromXZ(-DirectionToOrigin, UpVector).Rotator();
+				break;
+			case EPointDirection::Outside:
+				PointRotation = FRotationMatrix::MakeFromXZ(DirectionToOrigin, UpVector).Rotator();
+				break;
+			default:
+				break;
+			}
+
+			NewTransform.SetRotation(PointRotation.Quaternion());
+			OutTransforms.Emplace(NewTransform);
+		}
+	}
+
+	/** Creates a transient spline meandering along the X axis. */
+	USplineComponent* MakeBenchmarkSpline()
+	{
+		constexpr int32 SplinePointsAmount = 200;
+		constexpr float PointsSpacing = 2500.f;
+		constexpr float Amplitude = 1000.f;
+
+		USplineComponent* SplineComponent = NewObject<USplineComponent>(GetTransientPackage());
+		TArray<FVector> Points;
+		Points.Reserve(SplinePointsAmount);
+
+		for (int32 i = 0; i < SplinePointsAmount; ++i)
+		{
+			const float X = i * PointsSpacing;
+			Points.Emplace(X, FMath::Sin(i * 0.7f) * Amplitude, FMath::Cos(i * 0.3f) * Amplitude * 0.25f);
+		}
+
+		SplineComponent->SetSplinePoints(Points, ESplineCoordinateSpace::Local, true);
+		return SplineComponent;
+	}
+
+	FString MakeCsv(const TArray<FBenchmarkResult>& Results)
+	{
+		FString Csv = TEXT("Name,RequestedPoints,Points,Iterations,NsPerPoint,")
+			TEXT("AllocationsPerCall,AllocatedBytesPerCall,PeakLiveBytes\n");
+
+		for (const FBenchmarkResult& Result : Results)
+		{
+			Csv += FString::Printf(TEXT("%s,%d,%d,%d,%.3f,%.2f,%.0f,%lld\n"),
+			                       *Result.Name,
+			                       Result.RequestedPoints,
+			                       Result.PointsAmount,
+			                       Result.Iterations,
+			                       Result.NanosecondsPerPoint,
+			                       Result.AllocationsPerCall,
+			                       Result.AllocatedBytesPerCall,
+			                       Result.PeakLiveBytes);
+		}
+
+		return Csv;
+	}
+}
+
+UTrickyUtilitiesBenchmarkCommandlet::UTrickyUtilitiesBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UTrickyUtilitiesBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 MaxPoints = 1000000;
+	FString Filter;
+	FParse::Value(*Params, TEXT("MaxPoints="), MaxPoints);
+	FParse::Value(*Params, TEXT("Filter="), Filter);
+
+	// Never deleted, other threads may still hold the pointer after GMalloc is restored.
+	FCountingMalloc* CountingMalloc = new FCountingMalloc(GMalloc);
+
+	TArray<FBenchmarkResult> Results;
+	bool bHasFailedChecks = false;
+
+	auto RunCase = [&](const FString& Name, const int32 PointsAmount, auto&& Function)
+	{
+		if (Filter.IsEmpty() || Name.Contains(Filter))
+		{
+			Results.Emplace(RunBenchmarkCase(*CountingMalloc, Name, PointsAmount, Function));
+		}
+	};
+
+	const UEnum* PatternTypeEnum = StaticEnum<EPatternType>();
+	USplineComponent* SplineComponent = MakeBenchmarkSpline();
+	SplineComponent->AddToRoot();
+	const float SplineLength = SplineComponent->GetSplineLength();
+
+	constexpr int32 PatternPointsAmount = 10;
+	const FTrickyPatternSettings SmallRingSettings = MakePatternSettings(EPatternType::Ring, PatternPointsAmount);
+
+	// Patterns are placed at a rotated and moved origin, so regeneration and re-basing do the same work.
+	const FTransform PatternOrigin(FRotator(0.f, 45.f, 0.f), FVector(100.f, 200.f, 300.f));
+
+	// Run with -corelimit=N to see how the parallel cases scale with the amount of cores.
+	UE_LOG(LogTrickyUtilitiesBenchmark,
+	       Display,
+	       TEXT("Running on %d worker threads"),
+	       FTaskGraphInterface::Get().GetNumWorkerThreads());
+
+	for (int32 PointsAmount = 10; PointsAmount <= MaxPoints; PointsAmount *= 10)
+	{
+		for (int32 i = 0; i < PatternTypeEnum->NumEnums() - 1; ++i)
+		{
+			const EPatternType PatternType = static_cast<EPatternType>(PatternTypeEnum->GetValueByIndex(i));
+			const FTrickyPatternSettings Settings = MakePatternSettings(PatternType, PointsAmount);
+			const FString PatternName = PatternTypeEnum->GetNameStringByIndex(i);
+
+			RunCase(PatternName, PointsAmount, [&]
+			{
+				TArray<FTransform> Transforms;
+				UTrickyUtilityLibrary::CalculatePatternTransforms(PatternOrigin, Settings, Transforms);
+				return Transforms.Num();
+			});
+
+			RunCase(PatternName + TEXT("Cached"), PointsAmount, [&]
+			{
+				TArray<FTransform> Transforms;
+				UTrickyUtilityLibrary::CalculateCachedPatternTransforms(PatternOrigin, Settings, Transforms);
+				return Transforms.Num();
+			});
+
+			// Moving an existing local space pattern, compared against the full regeneration above.
+			TArray<FTransform> LocalTransforms;
+			UTrickyUtilityLibrary::CalculatePatternTransforms(FTransform::Identity, Settings, LocalTransforms);
+
+			RunCase(PatternName + TEXT("Rebase"), PointsAmount, [&]
+			{
+				TArray<FTransform> Transforms;
+				UTrickyUtilityLibrary::RebasePatternTransforms(LocalTransforms, PatternOrigin, Transforms);
+				return Transforms.Num();
+			});
+
+			if (IsCompositePattern(PatternType))
+			{
+				// Composite generators must allocate the output once instead of once per ring or arc.
+				// Serial generation keeps all allocations of the call on this thread.
+				const FScopedParallelPatternThreshold ScopedThreshold(0);
+				TArray<FTransform> Transforms;
+				const int64 AllocationsAmount = CountThreadAllocations(*CountingMalloc, [&]
+				{
+					UTrickyUtilityLibrary::CalculatePatternTransforms(PatternOrigin, Settings, Transforms);
+				});
+
+				if (AllocationsAmount > 1)
+				{
+					UE_LOG(LogTrickyUtilitiesBenchmark,
+					       Error,
+					       TEXT("%s made %lld allocations for %d points, expected at most 1"),
+					       *PatternName,
+					       AllocationsAmount,
+					       Transforms.Num());
+					bHasFailedChecks = true;
+				}
+			}
+		}
+
+		RunCase(TEXT("TransformsAlongSplineByPoints"), PointsAmount, [&]
+		{
+			TArray<FTransform> Transforms;
+			UTrickyUtilityLibrary::GetTransformsAlongSplineByPoints(SplineComponent, PointsAmount, false, Transforms);
+			return Transforms.Num();
+		});
+
+		RunCase(TEXT("LocationsAlongSplineByPoints"), PointsAmount, [&]
+		{
+			TArray<FVector> Locations;
+			UTrickyUtilityLibrary::GetLocationsAlongSplineByPoints(SplineComponent, PointsAmount, false, Locations);
+			return Locations.Num();
+		});
+
+		// The loop the spline functions used before the cursor based sampler, kept as a reference.
+		RunCase(TEXT("EngineTransformsAlongSpline"), PointsAmount, [&]
+		{
+			TArray<FTransform> Transforms;
+			const float Displacement = SplineComponent->GetSplineLength() / FMath::Max(1, PointsAmount - 1);
+
+			for (int32 i = 0; i < PointsAmount; ++i)
+			{
+				const float Distance = Displacement * i;
+				Transforms.Emplace(SplineComponent->GetTransformAtDistanceAlongSpline(Distance,
+				                                                                      ESplineCoordinateSpace::World));
+			}
+
+			return Transforms.Num();
+		});
+
+		RunCase(TEXT("PatternTransformsForOrigins"), PointsAmount, [&]
+		{
+			const int32 OriginsAmount = FMath::Max(1, PointsAmount / PatternPointsAmount);
+			TArray<FTransform> Origins;
+			Origins.Reserve(OriginsAmount);
+
+			for (int32 i = 0; i < OriginsAmount; ++i)
+			{
+				Origins.Emplace(FVector(i * 100.f, 0.f, 0.f));
+			}
+
+			TArray<FTransform> Transforms;
+			TArray<int32> Offsets;
+			UTrickyUtilityLibrary::CalculatePatternTransformsForOrigins(Origins, SmallRingSettings, Transforms, Offsets);
+			return Transforms.Num();
+		});
+
+		// Serial and parallel grid and cube generation must produce the same transforms.
+		for (const EPatternType PatternType : {EPatternType::Grid, EPatternType::Cube})
+		{
+			const FTrickyPatternSettings Settings = MakePatternSettings(PatternType, PointsAmount);
+			const FString PatternName = PatternTypeEnum->GetNameStringByValue(static_cast<int64>(PatternType));
+			TArray<FTransform> SerialTransforms;
+			TArray<FTransform> ParallelTransforms;
+
+			auto RunThreadingCase = [&](const FString& Name, const int32 Threshold, TArray<FTransform>& OutTransforms)
+			{
+				const FScopedParallelPatternThreshold ScopedThreshold(Threshold);
+
+				RunCase(Name, PointsAmount, [&]
+				{
+					TArray<FTransform> Transforms;
+					UTrickyUtilityLibrary::CalculatePatternTransforms(PatternOrigin, Settings, Transforms);
+					return Transforms.Num();
+				});
+
+				UTrickyUtilityLibrary::CalculatePatternTransforms(PatternOrigin, Settings, OutTransforms);
+			};
+
+			RunThreadingCase(PatternName + TEXT("Serial"), 0, SerialTransforms);
+			RunThreadingCase(PatternName + TEXT("Parallel"), 1, ParallelTransforms);
+
+			if (!AreTransformsIdentical(SerialTransforms, ParallelTransforms))
+			{
+				UE_LOG(LogTrickyUtilitiesBenchmark,
+				       Error,
+				       TEXT("Parallel %s output differs from the serial one at %d points"),
+				       *PatternName,
+				       PointsAmount);
+				bHasFailedChecks = true;
+			}
+		}
+
+		const FTrickyPatternSettings RingSettings = MakePatternSettings(EPatternType::Ring, PointsAmount);
+
+		RunCase(TEXT("RingScalarReference"), PointsAmount, [&]
+		{
+			TArray<FTransform> Transforms;
+			CalculateScalarRingTransforms(PatternOrigin,
+			                              RingSettings.PointsAmount,
+			                              RingSettings.Radius,
+			                              RingSettings.Direction,
+			                              Transforms);
+			return Transforms.Num();
+		});
+
+		const FBenchmarkResult* RingResult = Results.FindByPredicate([PointsAmount](const FBenchmarkResult& Result)
+		{
+			return Result.Name == TEXT("Ring") && Result.RequestedPoints == PointsAmount;
+		});
+
+		if (RingResult != nullptr && Results.Last().Name == TEXT("RingScalarReference"))
+		{
+			UE_LOG(LogTrickyUtilitiesBenchmark,
+			       Display,
+			       TEXT("Ring speedup over the scalar reference at %d points: %.2fx"),
+			       PointsAmount,
+			       Results.Last().NanosecondsPerPoint / FMath::Max(RingResult->NanosecondsPerPoint, UE_SMALL_NUMBER));
+		}
+
+		const float SampleDistance = SplineLength / PointsAmount;
+
+		RunCase(TEXT("TransformsAlongSplineByDistance"), PointsAmount, [&]
+		{
+			TArray<FTransform> Transforms;
+			UTrickyUtilityLibrary::GetTransformsAlongSplineByDistance(SplineComponent, SampleDistance, false, Transforms);
+			return Transforms.Num();
+		});
+
+		RunCase(TEXT("LocationsAlongSplineByDistance"), PointsAmount, [&]
+		{
+			TArray<FVector> Locations;
+			UTrickyUtilityLibrary::GetLocationsAlongSplineByDistance(SplineComponent, SampleDistance, false, Locations);
+			return Locations.Num();
+		});
+
+		RunCase(TEXT("TransformsAlongSplineByCurvature"), PointsAmount, [&]
+		{
+			// Slightly longer than the shortest allowed step, so the largest size isn't rejected by rounding.
+			const float MinDistance = SampleDistance * 1.01f;
+			TArray<FTransform> Transforms;
+			UTrickyUtilityLibrary::GetTransformsAlongSplineByCurvature(SplineComponent,
+			                                                           MinDistance,
+			                                                           MinDistance * 16.f,
+			                                                           1.f,
+			                                                           false,
+			                                                           Transforms);
+			return Transforms.Num();
+		});
+
+		RunCase(TEXT("SweepPatternAlongSpline"), PointsAmount, [&]
+		{
+			TArray<FTransform> Transforms;
+			UTrickyUtilityLibrary::SweepPatternAlongSpline(SplineComponent,
+			                                               SmallRingSettings,
+			                                               SampleDistance * PatternPointsAmount,
+			                                               false,
+			                                               Transforms);
+			return Transforms.Num();
+		});
+
+		RunCase(TEXT("BakeSplineToPolyline"), PointsAmount, [&]
+		{
+			TArray<FVector> Locations;
+			UTrickyUtilityLibrary::BakeSplineToPolyline(SplineComponent, 1000.f / PointsAmount, false, Locations);
+			return Locations.Num();
+		});
+
+		RunCase(TEXT("TransformsAlongSplines"), PointsAmount, [&]
+		{
+			constexpr int32 SplinesAmount = 10;
+			TArray<USplineComponent*> SplineComponents;
+			SplineComponents.Init(SplineComponent, SplinesAmount);
+
+			FTrickySplineSamplingSettings SamplingSettings;
+			SamplingSettings.SamplingMode = ESplineSamplingMode::ByPoints;
+			SamplingSettings.PointsAmount = FMath::Max(1, PointsAmount / SplinesAmount);
+
+			TArray<FTransform> Transforms;
+			TArray<int32> Offsets;
+			UTrickyUtilityLibrary::GetTransformsAlongSplines(SplineComponents, {SamplingSettings}, Transforms, Offsets);
+			return Transforms.Num();
+		});
+	}
+
+	SplineComponent->RemoveFromRoot();
+	FTrickyPatternCache::Get().Reset();
+
+	const FString CsvPath = FPaths::Combine(FPaths::ProjectSavedDir(),
+	                                        TEXT("TrickyUtilities"),
+	                                        FString::Printf(TEXT("Benchmark-%s.csv"), *FDateTime::Now().ToString()));
+
+	if (!FFileHelper::SaveStringToFile(MakeCsv(Results), *CsvPath))
+	{
+		UE_LOG(LogTrickyUtilitiesBenchmark, Error, TEXT("Failed to write %s"), *CsvPath);
+		return 1;
+	}
+
+	UE_LOG(LogTrickyUtilitiesBenchmark, Display, TEXT("Results were written to %s"), *CsvPath);
+	return bHasFailedChecks ? 1 : 0;
+}
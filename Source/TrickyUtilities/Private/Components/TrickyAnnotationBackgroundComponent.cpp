@@ -0,0 +1,21 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+
+#include "Components/TrickyAnnotationBackgroundComponent.h"
+
+
+FPrimitiveSceneProxy* UTrickyAnnotationBackgroundComponent::CreateSceneProxy()
+{
+	return bIsRenderedByBatch ? nullptr : Super::CreateSceneProxy();
+}
+
+void UTrickyAnnotationBackgroundComponent::SetRenderedByBatch(const bool bNewRenderedByBatch)
+{
+	if (bIsRenderedByBatch == bNewRenderedByBatch)
+	{
+		return;
+	}
+
+	bIsRenderedByBatch = bNewRenderedByBatch;
+	MarkRenderStateDirty();
+}
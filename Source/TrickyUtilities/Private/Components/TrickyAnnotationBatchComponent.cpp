@@ -0,0 +1,44 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+
+#include "Components/TrickyAnnotationBatchComponent.h"
+
+#include "Actors/TrickyAnnotationActor.h"
+#include "EngineUtils.h"
+#include "Subsystems/TrickyAnnotationSubsystem.h"
+
+
+UTrickyAnnotationBatchComponent::UTrickyAnnotationBatchComponent()
+{
+	bHasPerInstanceHitProxies = true;
+}
+
+#if WITH_EDITOR
+void UTrickyAnnotationBatchComponent::CreateHitProxyData(TArray<TRefCountPtr<HHitProxy>>& HitProxies)
+{
+	const UTrickyAnnotationSubsystem* Subsystem = GetTypedOuter<UTrickyAnnotationSubsystem>();
+
+	if (!GIsEditor || !IsValid(Subsystem))
+	{
+		Super::CreateHitProxyData(HitProxies);
+		return;
+	}
+
+	const int32 InstancesAmount = GetInstanceCount();
+	HitProxies.Empty(InstancesAmount);
+
+	for (int32 i = 0; i < InstancesAmount; ++i)
+	{
+		// Instances 2 * n and 2 * n + 1 are the front and back backgrounds of the n-th annotation of the batch.
+		ATrickyAnnotationActor* Annotation = Subsystem->GetBatchedAnnotation(this, i / 2);
+
+		if (IsValid(Annotation))
+		{
+			HitProxies.Add(new HActor(Annotation, Annotation->GetBackgroundComponent(i % 2)));
+			continue;
+		}
+
+		HitProxies.Add(new HInstancedStaticMeshInstance(this, i));
+	}
+}
+#endif
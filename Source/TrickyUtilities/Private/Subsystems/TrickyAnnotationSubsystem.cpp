@@ -0,0 +1,265 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+
+#include "Subsystems/TrickyAnnotationSubsystem.h"
+
+#include "Actors/TrickyAnnotationActor.h"
+#include "Components/TrickyAnnotationBatchComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Materials/MaterialInterface.h"
+#include "TrickyUtilitiesStats.h"
+
+static bool GTrickyBatchAnnotationBackgrounds = true;
+static FAutoConsoleVariableRef CVarTrickyBatchAnnotationBackgrounds(
+	TEXT("TrickyUtilities.BatchAnnotationBackgrounds"),
+	GTrickyBatchAnnotationBackgrounds,
+	TEXT("If true, backgrounds of annotations are rendered as instances, one component per mesh and material. ")
+	TEXT("Affects annotations registered after the change."),
+	ECVF_Default);
+
+void UTrickyAnnotationSubsystem::Deinitialize()
+{
+	for (const FTrickyAnnotationBackgroundBatch& Batch : Batches)
+	{
+		if (IsValid(Batch.Component))
+		{
+			Batch.Component->DestroyComponent();
+		}
+	}
+
+	Batches.Reset();
+	AnnotationSlots.Reset();
+
+	Super::Deinitialize();
+}
+
+void UTrickyAnnotationSubsystem::Tick(float DeltaTime)
+{
+	TRICKY_UTILITIES_SCOPE(AnnotationSubsystemTick);
+	LLM_SCOPE_BYTAG(TrickyUtilities_Annotations);
+
+	Super::Tick(DeltaTime);
+
+	for (FTrickyAnnotationBackgroundBatch& Batch : Batches)
+	{
+		UpdateBatch(Batch);
+	}
+}
+
+TStatId UTrickyAnnotationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTrickyAnnotationSubsystem, STATGROUP_Tickables);
+}
+
+UTrickyAnnotationSubsystem* UTrickyAnnotationSubsystem::GetBatchingSubsystem(const UWorld* World)
+{
+	if (!GTrickyBatchAnnotationBackgrounds || !IsValid(World))
+	{
+		return nullptr;
+	}
+
+	return World->GetSubsystem<UTrickyAnnotationSubsystem>();
+}
+
+bool UTrickyAnnotationSubsystem::RegisterAnnotation(ATrickyAnnotationActor* Annotation)
+{
+	if (!IsValid(Annotation))
+	{
+		return false;
+	}
+
+	UStaticMesh* Mesh = nullptr;
+	UMaterialInterface* Material = nullptr;
+
+	if (!Annotation->GetBackgroundMeshAndMaterial(Mesh, Material))
+	{
+		UnregisterAnnotation(Annotation);
+		return false;
+	}
+
+	if (const FIntPoint* Slot = AnnotationSlots.Find(Annotation))
+	{
+		const FTrickyAnnotationBackgroundBatch& Batch = Batches[Slot->X];
+
+		if (Batch.Mesh == TObjectKey<UStaticMesh>(Mesh) && Batch.Material == TObjectKey<UMaterialInterface>(Material))
+		{
+			MarkAnnotationDirty(Annotation);
+			return true;
+		}
+
+		UnregisterAnnotation(Annotation);
+	}
+
+	const int32 BatchIndex = FindOrAddBatch(Mesh, Material);
+	const int32 Index = Batches[BatchIndex].Annotations.Add(Annotation);
+	AnnotationSlots.Add(Annotation, FIntPoint(BatchIndex, Index));
+	return true;
+}
+
+void UTrickyAnnotationSubsystem::UnregisterAnnotation(ATrickyAnnotationActor* Annotation)
+{
+	FIntPoint Slot;
+
+	if (!AnnotationSlots.RemoveAndCopyValue(Annotation, Slot))
+	{
+		return;
+	}
+
+	FTrickyAnnotationBackgroundBatch& Batch = Batches[Slot.X];
+	const int32 Index = Slot.Y;
+	const int32 LastIndex = Batch.Annotations.Num() - 1;
+
+	// Mirrors RemoveAtSwap of the annotations in the instances, so no other instance has to be touched.
+	Batch.DirtyIndices.Remove(Index);
+
+	if (Index != LastIndex)
+	{
+		Batch.Annotations[Index] = Batch.Annotations[LastIndex];
+		AnnotationSlots.Add(Batch.Annotations[Index].Get(), FIntPoint(Slot.X, Index));
+
+		if (Index < Batch.InstancedAmount)
+		{
+			Batch.DirtyIndices.Remove(LastIndex);
+			Batch.DirtyIndices.Add(Index);
+		}
+	}
+
+	Batch.Annotations.RemoveAt(LastIndex);
+
+	if (Batch.InstancedAmount > LastIndex)
+	{
+		Batch.InstancedAmount = LastIndex;
+
+		if (IsValid(Batch.Component))
+		{
+			Batch.Component->RemoveInstances({LastIndex * 2, LastIndex * 2 + 1});
+		}
+	}
+}
+
+void UTrickyAnnotationSubsystem::MarkAnnotationDirty(ATrickyAnnotationActor* Annotation)
+{
+	if (const FIntPoint* Slot = AnnotationSlots.Find(Annotation))
+	{
+		FTrickyAnnotationBackgroundBatch& Batch = Batches[Slot->X];
+
+		if (Slot->Y < Batch.InstancedAmount)
+		{
+			Batch.DirtyIndices.Add(Slot->Y);
+		}
+	}
+}
+
+ATrickyAnnotationActor* UTrickyAnnotationSubsystem::GetBatchedAnnotation(
+	const UTrickyAnnotationBatchComponent* Component,
+	const int32 Index) const
+{
+	const FTrickyAnnotationBackgroundBatch* Batch = Batches.FindByPredicate(
+		[Component](const FTrickyAnnotationBackgroundBatch& Batch)
+		{
+			return Batch.Component == Component;
+		});
+
+	if (Batch == nullptr || !Batch->Annotations.IsValidIndex(Index) || Index >= Batch->InstancedAmount)
+	{
+		return nullptr;
+	}
+
+	return Batch->Annotations[Index].Get();
+}
+
+int32 UTrickyAnnotationSubsystem::FindOrAddBatch(UStaticMesh* Mesh, UMaterialInterface* Material)
+{
+	const TObjectKey<UStaticMesh> MeshKey(Mesh);
+	const TObjectKey<UMaterialInterface> MaterialKey(Material);
+	const int32 ExistingIndex = Batches.IndexOfByPredicate([&](const FTrickyAnnotationBackgroundBatch& Batch)
+	{
+		return Batch.Mesh == MeshKey && Batch.Material == MaterialKey;
+	});
+
+	if (ExistingIndex != INDEX_NONE)
+	{
+		return ExistingIndex;
+	}
+
+	FTrickyAnnotationBackgroundBatch& Batch = Batches.AddDefaulted_GetRef();
+	Batch.Mesh = MeshKey;
+	Batch.Material = MaterialKey;
+
+	// The component has no owner, so it doesn't appear in the level and isn't saved with it.
+	Batch.Component = NewObject<UTrickyAnnotationBatchComponent>(this, NAME_None, RF_Transient);
+	Batch.Component->SetStaticMesh(Mesh);
+	Batch.Component->SetMaterial(0, Material);
+	Batch.Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Batch.Component->SetCollisionResponseToAllChannels(ECR_Ignore);
+	Batch.Component->SetCanEverAffectNavigation(false);
+	Batch.Component->SetCastShadow(false);
+	Batch.Component->SetReceivesDecals(false);
+
+	if (UWorld* World = GetWorld())
+	{
+		Batch.Component->RegisterComponentWithWorld(World);
+	}
+
+	return Batches.Num() - 1;
+}
+
+void UTrickyAnnotationSubsystem::UpdateBatch(FTrickyAnnotationBackgroundBatch& Batch)
+{
+	if (!IsValid(Batch.Component))
+	{
+		return;
+	}
+
+	const bool bHasNewAnnotations = Batch.InstancedAmount < Batch.Annotations.Num();
+
+	if (!bHasNewAnnotations && Batch.DirtyIndices.IsEmpty())
+	{
+		return;
+	}
+
+	TArray<FTransform> Transforms;
+
+	for (const int32 Index : Batch.DirtyIndices)
+	{
+		const ATrickyAnnotationActor* Annotation = Batch.Annotations[Index].Get();
+
+		if (!IsValid(Annotation))
+		{
+			continue;
+		}
+
+		Transforms.Reset();
+		Annotation->GetBackgroundTransforms(Transforms);
+		Batch.Component->BatchUpdateInstancesTransforms(Index * 2, Transforms, false, false, true);
+	}
+
+	Batch.DirtyIndices.Reset();
+
+	if (bHasNewAnnotations)
+	{
+		// Annotations registered since the last tick are appended together.
+		Transforms.Reset();
+		Transforms.Reserve((Batch.Annotations.Num() - Batch.InstancedAmount) * 2);
+
+		for (int32 i = Batch.InstancedAmount; i < Batch.Annotations.Num(); ++i)
+		{
+			if (const ATrickyAnnotationActor* Annotation = Batch.Annotations[i].Get())
+			{
+				Annotation->GetBackgroundTransforms(Transforms);
+				continue;
+			}
+
+			const FTransform HiddenTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+			Transforms.Add(HiddenTransform);
+			Transforms.Add(HiddenTransform);
+		}
+
+		Batch.Component->AddInstances(Transforms, false);
+		Batch.InstancedAmount = Batch.Annotations.Num();
+	}
+
+	Batch.Component->MarkRenderStateDirty();
+}
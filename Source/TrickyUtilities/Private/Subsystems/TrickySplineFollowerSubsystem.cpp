@@ -0,0 +1,207 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+
+#include "Subsystems/TrickySplineFollowerSubsystem.h"
+
+#include "Actors/TrickySplineActor.h"
+#include "Async/ParallelFor.h"
+#include "Components/SceneComponent.h"
+#include "Components/SplineComponent.h"
+#include "TrickyUtilitiesStats.h"
+
+namespace
+{
+	constexpr int32 FollowersChunkSize = 1024;
+
+	struct FSplineFrame
+	{
+		const FTrickySplineLookupTable* LookupTable = nullptr;
+
+		FTransform ComponentTransform = FTransform::Identity;
+	};
+}
+
+void UTrickySplineFollowerSubsystem::Tick(float DeltaTime)
+{
+	TRICKY_UTILITIES_SCOPE(SplineFollowerSubsystemTick);
+
+	Super::Tick(DeltaTime);
+
+	const int32 FollowersAmount = Distances.Num();
+
+	if (FollowersAmount == 0)
+	{
+		return;
+	}
+
+	// Lookup tables are rebuilt on the game thread if needed before the workers read them.
+	TArray<FSplineFrame, TInlineAllocator<16>> SplineFrames;
+	SplineFrames.SetNum(Splines.Num());
+
+	for (int32 i = 0; i < Splines.Num(); ++i)
+	{
+		ATrickySplineActor* SplineActor = Splines[i].Get();
+
+		if (!IsValid(SplineActor))
+		{
+			continue;
+		}
+
+		SplineFrames[i].LookupTable = &SplineActor->GetLookupTable();
+		SplineFrames[i].ComponentTransform = SplineActor->GetSplineComponent()->GetComponentTransform();
+	}
+
+	FollowerTransforms.SetNumUninitialized(FollowersAmount);
+
+	const int32 ChunksAmount = FMath::DivideAndRoundUp(FollowersAmount, FollowersChunkSize);
+	ParallelFor(ChunksAmount, [&](const int32 ChunkIndex)
+	{
+		const int32 StartIndex = ChunkIndex * FollowersChunkSize;
+		const int32 EndIndex = FMath::Min(StartIndex + FollowersChunkSize, FollowersAmount);
+
+		for (int32 i = StartIndex; i < EndIndex; ++i)
+		{
+			const FSplineFrame& SplineFrame = SplineFrames[SplineIndices[i]];
+
+			if (SplineFrame.LookupTable == nullptr)
+			{
+				continue;
+			}
+
+			const float SplineLength = SplineFrame.LookupTable->GetSplineLength();
+			float Distance = Distances[i] + Speeds[i] * DeltaTime;
+
+			if (Loops[i] && SplineLength > 0.f)
+			{
+				Distance = FMath::Fmod(Distance, SplineLength);
+				Distance = Distance < 0.f ? Distance + SplineLength : Distance;
+			}
+			else
+			{
+				Distance = FMath::Clamp(Distance, 0.f, SplineLength);
+			}
+
+			Distances[i] = Distance;
+			FollowerTransforms[i] = SplineFrame.LookupTable->GetTransformAtDistance(Distance)
+				* SplineFrame.ComponentTransform;
+		}
+	});
+
+	// Components can be moved only on the game thread. Going backwards lets removed followers be swapped with
+	// already applied ones. Removing followers can also move splines, so they're checked directly.
+	for (int32 i = FollowersAmount - 1; i >= 0; --i)
+	{
+		USceneComponent* Target = Targets[i].Get();
+
+		if (!IsValid(Target) || !IsValid(Splines[SplineIndices[i]].Get()))
+		{
+			RemoveFollowerAt(i);
+			continue;
+		}
+
+		Target->SetWorldLocationAndRotation(FollowerTransforms[i].GetLocation(), FollowerTransforms[i].GetRotation());
+	}
+}
+
+TStatId UTrickySplineFollowerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTrickySplineFollowerSubsystem, STATGROUP_Tickables);
+}
+
+int32 UTrickySplineFollowerSubsystem::AddFollower(ATrickySplineActor* SplineActor,
+                                                  USceneComponent* Target,
+                                                  const float Speed,
+                                                  const float StartDistance,
+                                                  const bool bLoop)
+{
+	LLM_SCOPE_BYTAG(TrickyUtilities);
+
+	if (!IsValid(SplineActor) || !IsValid(Target))
+	{
+		return INDEX_NONE;
+	}
+
+	int32 SplineIndex = Splines.IndexOfByKey(SplineActor);
+
+	if (SplineIndex == INDEX_NONE)
+	{
+		SplineIndex = Splines.Emplace(SplineActor);
+		SplineFollowersAmounts.Emplace(0);
+	}
+
+	++SplineFollowersAmounts[SplineIndex];
+
+	const int32 FollowerId = NextFollowerId++;
+	FollowerIndices.Add(FollowerId, Distances.Num());
+	Distances.Emplace(StartDistance);
+	Speeds.Emplace(Speed);
+	Loops.Emplace(bLoop);
+	SplineIndices.Emplace(SplineIndex);
+	Targets.Emplace(Target);
+	FollowerIds.Emplace(FollowerId);
+	return FollowerId;
+}
+
+void UTrickySplineFollowerSubsystem::RemoveFollower(const int32 FollowerId)
+{
+	if (const int32* Index = FollowerIndices.Find(FollowerId))
+	{
+		RemoveFollowerAt(*Index);
+	}
+}
+
+void UTrickySplineFollowerSubsystem::SetFollowerSpeed(const int32 FollowerId, const float Speed)
+{
+	if (const int32* Index = FollowerIndices.Find(FollowerId))
+	{
+		Speeds[*Index] = Speed;
+	}
+}
+
+float UTrickySplineFollowerSubsystem::GetFollowerDistance(const int32 FollowerId) const
+{
+	const int32* Index = FollowerIndices.Find(FollowerId);
+	return Index ? Distances[*Index] : 0.f;
+}
+
+void UTrickySplineFollowerSubsystem::RemoveFollowerAt(const int32 Index)
+{
+	FollowerIndices.Remove(FollowerIds[Index]);
+
+	const int32 LastIndex = FollowerIds.Num() - 1;
+	const int32 SplineIndex = SplineIndices[Index];
+
+	if (Index != LastIndex)
+	{
+		FollowerIndices[FollowerIds[LastIndex]] = Index;
+	}
+
+	Distances.RemoveAtSwap(Index);
+	Speeds.RemoveAtSwap(Index);
+	Loops.RemoveAtSwap(Index);
+	SplineIndices.RemoveAtSwap(Index);
+	Targets.RemoveAtSwap(Index);
+	FollowerIds.RemoveAtSwap(Index);
+
+	if (--SplineFollowersAmounts[SplineIndex] > 0)
+	{
+		return;
+	}
+
+	const int32 LastSplineIndex = Splines.Num() - 1;
+	Splines.RemoveAtSwap(SplineIndex);
+	SplineFollowersAmounts.RemoveAtSwap(SplineIndex);
+
+	if (SplineIndex == LastSplineIndex)
+	{
+		return;
+	}
+
+	for (int32& FollowerSplineIndex : SplineIndices)
+	{
+		if (FollowerSplineIndex == LastSplineIndex)
+		{
+			FollowerSplineIndex = SplineIndex;
+		}
+	}
+}
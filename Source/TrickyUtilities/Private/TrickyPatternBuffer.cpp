@@ -0,0 +1,51 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+
+#include "TrickyPatternBuffer.h"
+
+void FTrickyPatternBuffer::Reset()
+{
+	Locations.Reset();
+	Rotations.Reset();
+	Scales.Reset();
+}
+
+void FTrickyPatternBuffer::Reserve(const int32 PointsAmount)
+{
+	Locations.Reserve(PointsAmount);
+	Rotations.Reserve(PointsAmount);
+
+	if (bStoreScales)
+	{
+		Scales.Reserve(PointsAmount);
+	}
+}
+
+int32 FTrickyPatternBuffer::AddUninitialized(const int32 PointsAmount)
+{
+	const int32 StartIndex = Locations.AddUninitialized(PointsAmount);
+	Rotations.AddUninitialized(PointsAmount);
+
+	if (bStoreScales)
+	{
+		Scales.AddUninitialized(PointsAmount);
+	}
+
+	return StartIndex;
+}
+
+FTransform FTrickyPatternBuffer::GetTransform(const int32 Index) const
+{
+	const FVector Scale = bStoreScales ? Scales[Index] : FVector::OneVector;
+	return FTransform(Rotations[Index], Locations[Index], Scale);
+}
+
+void FTrickyPatternBuffer::GetTransforms(TArray<FTransform>& OutTransforms) const
+{
+	OutTransforms.Reserve(OutTransforms.Num() + Num());
+
+	for (int32 i = 0; i < Num(); ++i)
+	{
+		OutTransforms.Emplace(GetTransform(i));
+	}
+}
@@ -0,0 +1,123 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+
+#include "TrickyPatternCache.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "TrickyUtilitiesStats.h"
+
+static int32 GTrickyPatternCacheBudgetKB = 16 * 1024;
+static FAutoConsoleVariableRef CVarTrickyPatternCacheBudgetKB(
+	TEXT("TrickyUtilities.PatternCacheBudgetKB"),
+	GTrickyPatternCacheBudgetKB,
+	TEXT("Memory budget of the pattern cache in kilobytes. 0 or less disables caching."),
+	ECVF_Default);
+
+FTrickyPatternCache& FTrickyPatternCache::Get()
+{
+	static FTrickyPatternCache Instance;
+	return Instance;
+}
+
+TSharedRef<const TArray<FTransform>> FTrickyPatternCache::GetLocalPattern(const FTrickyPatternSettings& Settings)
+{
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+
+	const int64 BudgetBytes = FMath::Max<int64>(static_cast<int64>(GTrickyPatternCacheBudgetKB) * 1024, 0);
+
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		// The budget can be lowered or set to 0 at any time, so stored patterns are trimmed before they're served.
+		EvictToBudget(BudgetBytes);
+
+		if (FEntry* Entry = BudgetBytes > 0 ? Entries.Find(Settings) : nullptr)
+		{
+			++HitsAmount;
+			LruList.RemoveNode(Entry->LruNode, false);
+			LruList.AddHead(Entry->LruNode);
+			return Entry->Transforms.ToSharedRef();
+		}
+
+		++MissesAmount;
+	}
+
+	TSharedRef<TArray<FTransform>> Transforms = MakeShared<TArray<FTransform>>();
+	UTrickyUtilityLibrary::CalculatePatternTransforms(FTransform::Identity, Settings, *Transforms);
+
+	const int64 SizeBytes = Transforms->GetAllocatedSize();
+
+	if (BudgetBytes == 0 || SizeBytes > BudgetBytes)
+	{
+		return Transforms;
+	}
+
+	FScopeLock Lock(&CriticalSection);
+
+	if (const FEntry* Entry = Entries.Find(Settings))
+	{
+		// Another thread generated the same pattern in the meantime.
+		return Entry->Transforms.ToSharedRef();
+	}
+
+	EvictToBudget(BudgetBytes - SizeBytes);
+
+	LruList.AddHead(Settings);
+	Entries.Add(Settings, FEntry{Transforms, SizeBytes, LruList.GetHead()});
+	UsedBytes += SizeBytes;
+
+	return Transforms;
+}
+
+void FTrickyPatternCache::CalculatePatternTransforms(const FTransform& Origin,
+                                                     const FTrickyPatternSettings& Settings,
+                                                     TArray<FTransform>& OutTransforms)
+{
+	const TSharedRef<const TArray<FTransform>> LocalTransforms = GetLocalPattern(Settings);
+	UTrickyUtilityLibrary::RebasePatternTransforms(*LocalTransforms, Origin, OutTransforms);
+}
+
+void FTrickyPatternCache::Reset()
+{
+	FScopeLock Lock(&CriticalSection);
+	Entries.Reset();
+	LruList.Empty();
+	UsedBytes = 0;
+	HitsAmount = 0;
+	MissesAmount = 0;
+}
+
+int64 FTrickyPatternCache::GetUsedBytes() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return UsedBytes;
+}
+
+int64 FTrickyPatternCache::GetHitsAmount() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return HitsAmount;
+}
+
+int64 FTrickyPatternCache::GetMissesAmount() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return MissesAmount;
+}
+
+void FTrickyPatternCache::EvictToBudget(const int64 BudgetBytes)
+{
+	while (UsedBytes > BudgetBytes && LruList.GetTail() != nullptr)
+	{
+		TDoubleLinkedList<FTrickyPatternSettings>::TDoubleLinkedListNode* LruNode = LruList.GetTail();
+		FEntry RemovedEntry;
+
+		if (Entries.RemoveAndCopyValue(LruNode->GetValue(), RemovedEntry))
+		{
+			UsedBytes -= RemovedEntry.SizeBytes;
+		}
+
+		LruList.RemoveNode(LruNode);
+	}
+}
@@ -0,0 +1,133 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+
+#include "TrickySplineLookupTable.h"
+#include "TrickyUtilitiesStats.h"
+
+#include "TrickySplineSampler.h"
+
+void FTrickySplineLookupTable::Build(const FSplineCurves& SplineCurves,
+                                     const FVector& DefaultUpVector,
+                                     const float MaxSampleStep)
+{
+	TRICKY_UTILITIES_SCOPE(SplineLookupTableBuild);
+	LLM_SCOPE_BYTAG(TrickyUtilities_SplineCaches);
+
+	Reset();
+
+	FTrickySplineSampler Sampler(SplineCurves, DefaultUpVector, FTransform::Identity);
+	SplineLength = Sampler.GetSplineLength();
+
+	// At least two samples are stored, so every query can interpolate between a pair of them.
+	const int32 SegmentsAmount = SplineLength > 0.f && MaxSampleStep > 0.f
+		                             ? FMath::Max(1, FMath::CeilToInt32(SplineLength / MaxSampleStep))
+		                             : 1;
+	const int32 SamplesAmount = SegmentsAmount + 1;
+	SampleStep = SplineLength / SegmentsAmount;
+	InverseSampleStep = SampleStep > 0.f ? 1.f / SampleStep : 0.f;
+
+	Locations.SetNumUninitialized(SamplesAmount);
+	Directions.SetNumUninitialized(SamplesAmount);
+	UpVectors.SetNumUninitialized(SamplesAmount);
+	Rolls.SetNumUninitialized(SamplesAmount);
+
+	for (int32 i = 0; i < SamplesAmount; ++i)
+	{
+		const float Distance = i == SegmentsAmount ? SplineLength : SampleStep * i;
+		const FTransform Transform = Sampler.GetTransformAtDistance(Distance, ESplineCoordinateSpace::Local);
+		const FQuat Rotation = Transform.GetRotation();
+
+		Locations[i] = Transform.GetLocation();
+		Directions[i] = Rotation.GetForwardVector();
+		UpVectors[i] = Rotation.GetUpVector();
+		Rolls[i] = Rotation.Rotator().Roll;
+	}
+}
+
+void FTrickySplineLookupTable::Reset()
+{
+	Locations.Reset();
+	Directions.Reset();
+	UpVectors.Reset();
+	Rolls.Reset();
+	SplineLength = 0.f;
+	SampleStep = 0.f;
+	InverseSampleStep = 0.f;
+}
+
+FVector FTrickySplineLookupTable::GetLocationAtDistance(const float Distance) const
+{
+	if (IsEmpty())
+	{
+		return FVector::ZeroVector;
+	}
+
+	int32 Index;
+	float Alpha;
+	GetSampleIndex(Distance, Index, Alpha);
+	return FMath::Lerp(Locations[Index], Locations[Index + 1], Alpha);
+}
+
+FVector FTrickySplineLookupTable::GetDirectionAtDistance(const float Distance) const
+{
+	if (IsEmpty())
+	{
+		return FVector::ForwardVector;
+	}
+
+	int32 Index;
+	float Alpha;
+	GetSampleIndex(Distance, Index, Alpha);
+	return FMath::Lerp(Directions[Index], Directions[Index + 1], Alpha).GetSafeNormal();
+}
+
+FVector FTrickySplineLookupTable::GetUpVectorAtDistance(const float Distance) const
+{
+	if (IsEmpty())
+	{
+		return FVector::UpVector;
+	}
+
+	int32 Index;
+	float Alpha;
+	GetSampleIndex(Distance, Index, Alpha);
+	return FMath::Lerp(UpVectors[Index], UpVectors[Index + 1], Alpha).GetSafeNormal();
+}
+
+float FTrickySplineLookupTable::GetRollAtDistance(const float Distance) const
+{
+	if (IsEmpty())
+	{
+		return 0.f;
+	}
+
+	int32 Index;
+	float Alpha;
+	GetSampleIndex(Distance, Index, Alpha);
+	const float DeltaRoll = FRotator::NormalizeAxis(Rolls[Index + 1] - Rolls[Index]);
+	return FRotator::NormalizeAxis(Rolls[Index] + DeltaRoll * Alpha);
+}
+
+FTransform FTrickySplineLookupTable::GetTransformAtDistance(const float Distance) const
+{
+	if (IsEmpty())
+	{
+		return FTransform::Identity;
+	}
+
+	int32 Index;
+	float Alpha;
+	GetSampleIndex(Distance, Index, Alpha);
+	const FVector Location = FMath::Lerp(Locations[Index], Locations[Index + 1], Alpha);
+	const FVector Direction = FMath::Lerp(Directions[Index], Directions[Index + 1], Alpha);
+	const FVector UpVector = FMath::Lerp(UpVectors[Index], UpVectors[Index + 1], Alpha);
+	return FTransform(FRotationMatrix::MakeFromXZ(Direction, UpVector).ToQuat(), Location);
+}
+
+void FTrickySplineLookupTable::GetSampleIndex(const float Distance, int32& OutIndex, float& OutAlpha) const
+{
+	const int32 LastSegment = Num() - 2;
+	const float Position = FMath::Clamp(Distance, 0.f, SplineLength) * InverseSampleStep;
+	OutIndex = FMath::Min(FMath::FloorToInt32(Position), LastSegment);
+	OutAlpha = Position - OutIndex;
+}
@@ -0,0 +1,219 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+
+#include "TrickySplineSampler.h"
+
+namespace
+{
+	/**
+	 * Returns the index of the last curve point with an input value not greater than InKey,
+	 * walking forward from the given hint. Falls back to a binary search if the hint is ahead of InKey.
+	 */
+	template <typename T>
+	int32 AdvancePointIndex(const FInterpCurve<T>& Curve, const float InKey, const int32 HintIndex)
+	{
+		const TArray<FInterpCurvePoint<T>>& Points = Curve.Points;
+
+		if (Points.IsEmpty() || InKey < Points[0].InVal)
+		{
+			return INDEX_NONE;
+		}
+
+		if (!Points.IsValidIndex(HintIndex) || Points[HintIndex].InVal > InKey)
+		{
+			return Curve.GetPointIndexForInputValue(InKey);
+		}
+
+		int32 Index = HintIndex;
+
+		while (Index + 1 < Points.Num() && Points[Index + 1].InVal <= InKey)
+		{
+			++Index;
+		}
+
+		return Index;
+	}
+}
+
+template <typename T>
+void FTrickySplineSampler::TCurveCursor<T>::Seek(const FInterpCurve<T>& Curve, const float InKey, const T& Default)
+{
+	const TArray<FInterpCurvePoint<T>>& Points = Curve.Points;
+	const int32 LastPoint = Points.Num() - 1;
+	const int32 Index = AdvancePointIndex(Curve, InKey, PointIndex);
+	const bool bPastLoop = Curve.bIsLooped
+		&& Index != INDEX_NONE
+		&& Index == LastPoint
+		&& InKey >= Points[LastPoint].InVal + Curve.LoopKeyOffset;
+
+	if (bIsValid && Index == PointIndex && bPastLoop == bIsPastLoop)
+	{
+		return;
+	}
+
+	bIsValid = true;
+	PointIndex = Index;
+	bIsPastLoop = bPastLoop;
+	bInterpolates = false;
+
+	// Mirrors FInterpCurve::Eval and FInterpCurve::EvalDerivative.
+	if (Points.IsEmpty())
+	{
+		ConstantValue = Default;
+		ConstantDerivative = Default;
+		return;
+	}
+
+	if (Index == INDEX_NONE)
+	{
+		ConstantValue = Points[0].OutVal;
+		ConstantDerivative = Points[0].LeaveTangent;
+		return;
+	}
+
+	if (Index == LastPoint && !Curve.bIsLooped)
+	{
+		ConstantValue = Points[LastPoint].OutVal;
+		ConstantDerivative = Points[LastPoint].ArriveTangent;
+		return;
+	}
+
+	if (bPastLoop)
+	{
+		ConstantValue = Points[0].OutVal;
+		ConstantDerivative = Points[0].ArriveTangent;
+		return;
+	}
+
+	const bool bLoopSegment = Curve.bIsLooped && Index == LastPoint;
+	const FInterpCurvePoint<T>& PrevPoint = Points[Index];
+	const FInterpCurvePoint<T>& NextPoint = Points[bLoopSegment ? 0 : Index + 1];
+	const float Diff = bLoopSegment ? Curve.LoopKeyOffset : NextPoint.InVal - PrevPoint.InVal;
+
+	if (Diff <= 0.f || PrevPoint.InterpMode == CIM_Constant)
+	{
+		ConstantValue = PrevPoint.OutVal;
+		ConstantDerivative = T(ForceInit);
+		return;
+	}
+
+	bInterpolates = true;
+	bIsLinear = PrevPoint.InterpMode == CIM_Linear;
+	StartKey = PrevPoint.InVal;
+	KeyRange = Diff;
+	StartValue = PrevPoint.OutVal;
+	EndValue = NextPoint.OutVal;
+	LeaveTangent = PrevPoint.LeaveTangent * Diff;
+	ArriveTangent = NextPoint.ArriveTangent * Diff;
+}
+
+template <typename T>
+T FTrickySplineSampler::TCurveCursor<T>::Eval(const float InKey) const
+{
+	if (!bInterpolates)
+	{
+		return ConstantValue;
+	}
+
+	const float Alpha = (InKey - StartKey) / KeyRange;
+
+	if (bIsLinear)
+	{
+		return FMath::Lerp(StartValue, EndValue, Alpha);
+	}
+
+	return FMath::CubicInterp(StartValue, LeaveTangent, EndValue, ArriveTangent, Alpha);
+}
+
+template <typename T>
+T FTrickySplineSampler::TCurveCursor<T>::EvalDerivative(const float InKey) const
+{
+	if (!bInterpolates)
+	{
+		return ConstantDerivative;
+	}
+
+	if (bIsLinear)
+	{
+		return (EndValue - StartValue) / KeyRange;
+	}
+
+	const float Alpha = (InKey - StartKey) / KeyRange;
+	return FMath::CubicInterpDerivative(StartValue, LeaveTangent, EndValue, ArriveTangent, Alpha) / KeyRange;
+}
+
+FTrickySplineSampler::FTrickySplineSampler(const USplineComponent& SplineComponent)
+	: FTrickySplineSampler(SplineComponent.SplineCurves,
+	                       SplineComponent.DefaultUpVector,
+	                       SplineComponent.GetComponentTransform())
+{
+}
+
+FTrickySplineSampler::FTrickySplineSampler(const FSplineCurves& InSplineCurves,
+                                           const FVector& InDefaultUpVector,
+                                           const FTransform& InComponentTransform)
+	: SplineCurves(InSplineCurves),
+	  DefaultUpVector(InDefaultUpVector),
+	  ComponentTransform(InComponentTransform)
+{
+}
+
+float FTrickySplineSampler::GetSplineLength() const
+{
+	return SplineCurves.GetSplineLength();
+}
+
+void FTrickySplineSampler::Reset()
+{
+	ReparamCursor = TCurveCursor<float>();
+	PositionCursor = TCurveCursor<FVector>();
+	RotationCursor = TCurveCursor<FQuat>();
+}
+
+float FTrickySplineSampler::GetInputKeyAtDistance(const float Distance)
+{
+	ReparamCursor.Seek(SplineCurves.ReparamTable, Distance, 0.f);
+	return ReparamCursor.Eval(Distance);
+}
+
+FVector FTrickySplineSampler::GetLocationAtDistance(const float Distance,
+                                                    const ESplineCoordinateSpace::Type CoordinateSpace)
+{
+	const float InputKey = GetInputKeyAtDistance(Distance);
+	PositionCursor.Seek(SplineCurves.Position, InputKey, FVector::ZeroVector);
+	const FVector Location = PositionCursor.Eval(InputKey);
+
+	return CoordinateSpace == ESplineCoordinateSpace::World
+		       ? ComponentTransform.TransformPosition(Location)
+		       : Location;
+}
+
+FVector FTrickySplineSampler::GetDirectionAtDistance(const float Distance,
+                                                     const ESplineCoordinateSpace::Type CoordinateSpace)
+{
+	const float InputKey = GetInputKeyAtDistance(Distance);
+	PositionCursor.Seek(SplineCurves.Position, InputKey, FVector::ZeroVector);
+	const FVector Direction = PositionCursor.EvalDerivative(InputKey).GetSafeNormal();
+
+	return CoordinateSpace == ESplineCoordinateSpace::World
+		       ? ComponentTransform.TransformVector(Direction).GetSafeNormal()
+		       : Direction;
+}
+
+FTransform FTrickySplineSampler::GetTransformAtDistance(const float Distance,
+                                                        const ESplineCoordinateSpace::Type CoordinateSpace)
+{
+	const float InputKey = GetInputKeyAtDistance(Distance);
+	PositionCursor.Seek(SplineCurves.Position, InputKey, FVector::ZeroVector);
+	RotationCursor.Seek(SplineCurves.Rotation, InputKey, FQuat::Identity);
+
+	FQuat Quat = RotationCursor.Eval(InputKey);
+	Quat.Normalize();
+
+	const FVector Direction = PositionCursor.EvalDerivative(InputKey).GetSafeNormal();
+	const FVector UpVector = Quat.RotateVector(DefaultUpVector);
+	const FQuat Rotation = FRotationMatrix::MakeFromXZ(Direction, UpVector).ToQuat();
+	const FTransform Transform(Rotation, PositionCursor.Eval(InputKey));
+
+	return CoordinateSpace == ESplineCoordinateSpace::World ? Transform * ComponentTransform : Transform;
+}
@@ -0,0 +1,140 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+
+#include "TrickySplineSegmentTree.h"
+#include "TrickyUtilitiesStats.h"
+
+#include "TrickySplineLookupTable.h"
+
+namespace
+{
+	constexpr int32 LeafSegmentsAmount = 4;
+
+	/** Halving the segments keeps the depth logarithmic, every level adds at most one entry to the stack. */
+	constexpr int32 MaxStackSize = 64;
+}
+
+void FTrickySplineSegmentTree::Build(const FTrickySplineLookupTable& LookupTable)
+{
+	TRICKY_UTILITIES_SCOPE(SplineSegmentTreeBuild);
+	LLM_SCOPE_BYTAG(TrickyUtilities_SplineCaches);
+
+	Reset();
+
+	if (LookupTable.Num() < 2)
+	{
+		return;
+	}
+
+	Points = LookupTable.Locations;
+	SegmentLength = LookupTable.GetSampleStep();
+
+	const int32 SegmentsAmount = Points.Num() - 1;
+	Nodes.Reserve(2 * FMath::DivideAndRoundUp(SegmentsAmount, LeafSegmentsAmount));
+	BuildNode(0, SegmentsAmount);
+}
+
+void FTrickySplineSegmentTree::Reset()
+{
+	Nodes.Reset();
+	Points.Reset();
+	SegmentLength = 0.f;
+}
+
+bool FTrickySplineSegmentTree::FindClosestPoint(const FVector& Location, float& OutDistance, FVector& OutLocation) const
+{
+	if (IsEmpty())
+	{
+		return false;
+	}
+
+	double BestDistanceSquared = TNumericLimits<double>::Max();
+	int32 BestSegment = 0;
+	double BestAlpha = 0.0;
+
+	int32 Stack[MaxStackSize];
+	int32 StackSize = 0;
+	Stack[StackSize++] = 0;
+
+	while (StackSize > 0)
+	{
+		const int32 NodeIndex = Stack[--StackSize];
+		const FNode& Node = Nodes[NodeIndex];
+
+		if (Node.Bounds.ComputeSquaredDistanceToPoint(Location) >= BestDistanceSquared)
+		{
+			continue;
+		}
+
+		if (Node.SecondChild == INDEX_NONE)
+		{
+			for (int32 i = Node.FirstSegment; i < Node.FirstSegment + Node.SegmentsAmount; ++i)
+			{
+				const FVector& Start = Points[i];
+				const FVector Segment = Points[i + 1] - Start;
+				const double SegmentSizeSquared = Segment.SizeSquared();
+				const double Alpha = SegmentSizeSquared > UE_SMALL_NUMBER
+					                     ? FMath::Clamp((Location - Start).Dot(Segment) / SegmentSizeSquared, 0.0, 1.0)
+					                     : 0.0;
+				const double DistanceSquared = FVector::DistSquared(Location, Start + Segment * Alpha);
+
+				if (DistanceSquared < BestDistanceSquared)
+				{
+					BestDistanceSquared = DistanceSquared;
+					BestSegment = i;
+					BestAlpha = Alpha;
+				}
+			}
+
+			continue;
+		}
+
+		// Push the farther child first, so the nearer one is visited first and prunes more.
+		const int32 FirstChild = NodeIndex + 1;
+		const double FirstDistanceSquared = Nodes[FirstChild].Bounds.ComputeSquaredDistanceToPoint(Location);
+		const double SecondDistanceSquared = Nodes[Node.SecondChild].Bounds.ComputeSquaredDistanceToPoint(Location);
+
+		if (FirstDistanceSquared < SecondDistanceSquared)
+		{
+			Stack[StackSize++] = Node.SecondChild;
+			Stack[StackSize++] = FirstChild;
+		}
+		else
+		{
+			Stack[StackSize++] = FirstChild;
+			Stack[StackSize++] = Node.SecondChild;
+		}
+	}
+
+	OutDistance = static_cast<float>((BestSegment + BestAlpha) * SegmentLength);
+	OutLocation = FMath::Lerp(Points[BestSegment], Points[BestSegment + 1], BestAlpha);
+	return true;
+}
+
+int32 FTrickySplineSegmentTree::BuildNode(const int32 FirstSegment, const int32 SegmentsAmount)
+{
+	const int32 NodeIndex = Nodes.AddDefaulted();
+	FBox Bounds(ForceInit);
+
+	for (int32 i = FirstSegment; i <= FirstSegment + SegmentsAmount; ++i)
+	{
+		Bounds += Points[i];
+	}
+
+	Nodes[NodeIndex].Bounds = Bounds;
+	Nodes[NodeIndex].FirstSegment = FirstSegment;
+	Nodes[NodeIndex].SegmentsAmount = SegmentsAmount;
+
+	if (SegmentsAmount <= LeafSegmentsAmount)
+	{
+		return NodeIndex;
+	}
+
+	const int32 FirstHalf = SegmentsAmount / 2;
+	BuildNode(FirstSegment, FirstHalf);
+
+	// Nodes may be reallocated while building the children, so the node is accessed by its index.
+	const int32 SecondChild = BuildNode(FirstSegment + FirstHalf, SegmentsAmount - FirstHalf);
+	Nodes[NodeIndex].SecondChild = SecondChild;
+	return NodeIndex;
+}
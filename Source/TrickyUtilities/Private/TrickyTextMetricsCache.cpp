@@ -0,0 +1,77 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+
+#include "TrickyTextMetricsCache.h"
+
+#include "Components/TextRenderComponent.h"
+#include "Engine/Font.h"
+#include "HAL/IConsoleManager.h"
+#include "TrickyUtilitiesStats.h"
+
+static int32 GTrickyTextMetricsCacheSize = 16 * 1024;
+static FAutoConsoleVariableRef CVarTrickyTextMetricsCacheSize(
+	TEXT("TrickyUtilities.TextMetricsCacheSize"),
+	GTrickyTextMetricsCacheSize,
+	TEXT("Maximum amount of text sizes stored by the annotation text metrics cache. 0 or less disables caching."),
+	ECVF_Default);
+
+bool FTrickyTextMetricsCache::FKey::operator==(const FKey& Other) const
+{
+	return Font == Other.Font
+		&& WorldSize == Other.WorldSize
+		&& XScale == Other.XScale
+		&& YScale == Other.YScale
+		&& HorizSpacingAdjust == Other.HorizSpacingAdjust
+		&& VertSpacingAdjust == Other.VertSpacingAdjust
+		&& Text.Equals(Other.Text, ESearchCase::CaseSensitive);
+}
+
+FTrickyTextMetricsCache& FTrickyTextMetricsCache::Get()
+{
+	static FTrickyTextMetricsCache Instance;
+	return Instance;
+}
+
+FVector FTrickyTextMetricsCache::GetTextLocalSize(const UTextRenderComponent& Component)
+{
+	LLM_SCOPE_BYTAG(TrickyUtilities_Annotations);
+
+	// Actors can be constructed on the async loading thread, the cache itself isn't thread safe.
+	if (GTrickyTextMetricsCacheSize <= 0 || !IsInGameThread())
+	{
+		return Component.GetTextLocalSize();
+	}
+
+	FKey Key;
+	Key.Text = Component.Text.ToString();
+	Key.Font = TObjectKey<UFont>(Component.Font);
+	Key.WorldSize = Component.WorldSize;
+	Key.XScale = Component.XScale;
+	Key.YScale = Component.YScale;
+	Key.HorizSpacingAdjust = Component.HorizSpacingAdjust;
+	Key.VertSpacingAdjust = Component.VertSpacingAdjust;
+
+	if (const FVector* Size = Entries.Find(Key))
+	{
+		++HitsAmount;
+		return *Size;
+	}
+
+	++MissesAmount;
+
+	if (Entries.Num() >= GTrickyTextMetricsCacheSize)
+	{
+		Entries.Reset();
+	}
+
+	const FVector Size = Component.GetTextLocalSize();
+	Entries.Add(MoveTemp(Key), Size);
+	return Size;
+}
+
+void FTrickyTextMetricsCache::Reset()
+{
+	Entries.Reset();
+	HitsAmount = 0;
+	MissesAmount = 0;
+}
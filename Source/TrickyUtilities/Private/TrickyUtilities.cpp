@@ -1,6 +1,17 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "TrickyUtilities.h"
+#include "TrickyUtilitiesStats.h"
+
+DEFINE_STAT(STAT_TrickyUtilities_PointsGenerated);
+DEFINE_STAT(STAT_TrickyUtilities_BytesWritten);
+
+UE_TRACE_CHANNEL_DEFINE(TrickyUtilitiesChannel);
+
+LLM_DEFINE_TAG(TrickyUtilities);
+LLM_DEFINE_TAG(TrickyUtilities_PatternBuffers, TEXT("PatternBuffers"), TEXT("TrickyUtilities"));
+LLM_DEFINE_TAG(TrickyUtilities_SplineCaches, TEXT("SplineCaches"), TEXT("TrickyUtilities"));
+LLM_DEFINE_TAG(TrickyUtilities_Annotations, TEXT("Annotations"), TEXT("TrickyUtilities"));
 
 #define LOCTEXT_NAMESPACE "FTrickyUtilitiesModule"
 
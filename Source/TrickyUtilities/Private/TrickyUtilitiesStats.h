@@ -0,0 +1,90 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TrickyPatternBuffer.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+DECLARE_STATS_GROUP(TEXT("TrickyUtilities"), STATGROUP_TrickyUtilities, STATCAT_Advanced);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Points Generated"),
+                                  STAT_TrickyUtilities_PointsGenerated,
+                                  STATGROUP_TrickyUtilities,
+                                  );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes Written"),
+                                  STAT_TrickyUtilities_BytesWritten,
+                                  STATGROUP_TrickyUtilities,
+                                  );
+
+/** Low level memory tracker tags of the plugin, shown in -llm reports under TrickyUtilities. */
+LLM_DECLARE_TAG(TrickyUtilities);
+LLM_DECLARE_TAG(TrickyUtilities_PatternBuffers);
+LLM_DECLARE_TAG(TrickyUtilities_SplineCaches);
+LLM_DECLARE_TAG(TrickyUtilities_Annotations);
+
+/** Trace channel of the plugin, enable it with -trace=cpu,TrickyUtilities to see only the plugin scopes. */
+UE_TRACE_CHANNEL_EXTERN(TrickyUtilitiesChannel);
+
+/**
+ * Adds a cycle counter shown by "stat TrickyUtilities" and a CPU trace event on TrickyUtilitiesChannel
+ * for the rest of the current scope.
+ */
+#define TRICKY_UTILITIES_SCOPE(Name) \
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT(#Name), STAT_TrickyUtilities_##Name, STATGROUP_TrickyUtilities); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(#Name, TrickyUtilitiesChannel)
+
+/**
+ * Adds the points appended to the given output during the rest of the current scope
+ * to the Points Generated and Bytes Written counters.
+ */
+template <typename ElementType>
+class TTrickyOutputStatScope
+{
+public:
+	explicit TTrickyOutputStatScope(const TArray<ElementType>& InOutput)
+		: Output(InOutput),
+		  StartNum(InOutput.Num())
+	{
+	}
+
+	~TTrickyOutputStatScope()
+	{
+		const int32 AddedAmount = FMath::Max(0, Output.Num() - StartNum);
+		INC_DWORD_STAT_BY(STAT_TrickyUtilities_PointsGenerated, AddedAmount);
+		INC_DWORD_STAT_BY(STAT_TrickyUtilities_BytesWritten, AddedAmount * sizeof(ElementType));
+	}
+
+private:
+	const TArray<ElementType>& Output;
+
+	int32 StartNum = 0;
+};
+
+/** Same as TTrickyOutputStatScope for pattern buffers. */
+class FTrickyBufferStatScope
+{
+public:
+	explicit FTrickyBufferStatScope(const FTrickyPatternBuffer& InOutput)
+		: Output(InOutput),
+		  StartNum(InOutput.Num())
+	{
+	}
+
+	~FTrickyBufferStatScope()
+	{
+		const int32 AddedAmount = FMath::Max(0, Output.Num() - StartNum);
+		const SIZE_T PointSize = sizeof(FVector) + sizeof(FQuat) + (Output.bStoreScales ? sizeof(FVector) : 0);
+		INC_DWORD_STAT_BY(STAT_TrickyUtilities_PointsGenerated, AddedAmount);
+		INC_DWORD_STAT_BY(STAT_TrickyUtilities_BytesWritten, AddedAmount * PointSize);
+	}
+
+private:
+	const FTrickyPatternBuffer& Output;
+
+	int32 StartNum = 0;
+};
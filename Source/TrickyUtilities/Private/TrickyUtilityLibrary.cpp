@@ -3,12 +3,1333 @@
 
 #include "TrickyUtilityLibrary.h"
 
+#include "TrickyPatternBuffer.h"
+#include "TrickyPatternCache.h"
+#include "TrickySplineSampler.h"
+#include "TrickyUtilitiesStats.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
 #include "Components/SplineComponent.h"
 #include "Components/TimelineComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "LatentActions.h"
+#include "Templates/IntegralConstant.h"
+
+static int32 GTrickyParallelPatternThreshold = 16384;
+static FAutoConsoleVariableRef CVarTrickyParallelPatternThreshold(
+	TEXT("TrickyUtilities.ParallelPatternThreshold"),
+	GTrickyParallelPatternThreshold,
+	TEXT("Minimal amount of points at which pattern generators split work across worker threads.\n")
+	TEXT("0 or less forces single threaded generation."),
+	ECVF_Default);
+
+namespace
+{
+	constexpr int32 PatternChunkSize = 4096;
+
+	/**
+	 * Calls Body(StartIndex, EndIndex) for disjoint index ranges covering [0, Num).
+	 * Ranges are processed on worker threads when Num reaches the parallel threshold, otherwise in a single call.
+	 */
+	template <typename BodyType>
+	void ForEachPointRange(const int32 Num, BodyType&& Body)
+	{
+		if (GTrickyParallelPatternThreshold <= 0 || Num < GTrickyParallelPatternThreshold)
+		{
+			Body(0, Num);
+			return;
+		}
+
+		const int32 ChunksAmount = FMath::DivideAndRoundUp(Num, PatternChunkSize);
+		ParallelFor(ChunksAmount, [&Body, Num](const int32 ChunkIndex)
+		{
+			const int32 StartIndex = ChunkIndex * PatternChunkSize;
+			Body(StartIndex, FMath::Min(StartIndex + PatternChunkSize, Num));
+		});
+	}
+
+	/** Writes generated points into an array of transforms. */
+	struct FTransformArrayWriter
+	{
+		explicit FTransformArrayWriter(TArray<FTransform>& InTransforms)
+			: Transforms(InTransforms)
+		{
+		}
+
+		int32 AddPoints(const int32 PointsAmount)
+		{
+			return Transforms.AddUninitialized(PointsAmount);
+		}
+
+		void SetPoint(const int32 Index, const FVector& Location, const FQuat& Rotation, const FVector& Scale)
+		{
+			new(Transforms.GetData() + Index) FTransform(Rotation, Location, Scale);
+		}
+
+		void SetPoint(const int32 Index, const FTransform& Transform)
+		{
+			new(Transforms.GetData() + Index) FTransform(Transform);
+		}
+
+	private:
+		TArray<FTransform>& Transforms;
+	};
+
+	/** Writes generated points into the separate arrays of a pattern buffer. */
+	struct FPatternBufferWriter
+	{
+		explicit FPatternBufferWriter(FTrickyPatternBuffer& InBuffer)
+			: Buffer(InBuffer)
+		{
+		}
+
+		int32 AddPoints(const int32 PointsAmount)
+		{
+			return Buffer.AddUninitialized(PointsAmount);
+		}
+
+		void SetPoint(const int32 Index, const FVector& Location, const FQuat& Rotation, const FVector& Scale)
+		{
+			Buffer.Locations.GetData()[Index] = Location;
+			Buffer.Rotations.GetData()[Index] = Rotation;
+
+			if (Buffer.bStoreScales)
+			{
+				Buffer.Scales.GetData()[Index] = Scale;
+			}
+		}
+
+		void SetPoint(const int32 Index, const FTransform& Transform)
+		{
+			SetPoint(Index, Transform.GetLocation(), Transform.GetRotation(), Transform.GetScale3D());
+		}
+
+	private:
+		FTrickyPatternBuffer& Buffer;
+	};
+
+	/**
+	 * Orients points relative to an origin for a direction known at compile time.
+	 * Origin derived values are computed once on construction.
+	 */
+	template <EPointDirection Direction>
+	struct TPointRotationSolver
+	{
+		explicit TPointRotationSolver(const FTransform& Origin)
+			: OriginRotation(Origin.GetRotation())
+			  , OriginLocation(Origin.GetLocation())
+			  , UpVector(OriginRotation.GetUpVector())
+		{
+		}
+
+		FQuat operator()(const FVector& PointLocation) const
+		{
+			if constexpr (Direction == EPointDirection::Origin)
+			{
+				return OriginRotation;
+			}
+			else
+			{
+				const FVector DirectionToPoint = (PointLocation - OriginLocation).GetSafeNormal();
+
+				if constexpr (Direction == EPointDirection::Clockwise)
+				{
+					const FVector TangentVector = FVector::CrossProduct(UpVector, DirectionToPoint);
+					return FRotationMatrix::MakeFromXZ(TangentVector, UpVector).ToQuat();
+				}
+				else if constexpr (Direction == EPointDirection::CounterClockwise)
+				{
+					const FVector TangentVector = FVector::CrossProduct(DirectionToPoint, UpVector);
+					return FRotationMatrix::MakeFromXZ(TangentVector, UpVector).ToQuat();
+				}
+				else if constexpr (Direction == EPointDirection::Inside)
+				{
+					return FRotationMatrix::MakeFromXZ(-DirectionToPoint, UpVector).ToQuat();
+				}
+				else
+				{
+					return FRotationMatrix::MakeFromXZ(DirectionToPoint, UpVector).ToQuat();
+				}
+			}
+		}
+
+	private:
+		FQuat OriginRotation;
+		FVector OriginLocation;
+		FVector UpVector;
+	};
+
+	/** Calls Function with a TIntegralConstant of the given direction to instantiate a specialized generator. */
+	template <typename FunctionType>
+	void DispatchPointDirection(const EPointDirection Direction, FunctionType&& Function)
+	{
+		switch (Direction)
+		{
+		case EPointDirection::Origin:
+			Function(TIntegralConstant<EPointDirection, EPointDirection::Origin>());
+			break;
+		case EPointDirection::Clockwise:
+			Function(TIntegralConstant<EPointDirection, EPointDirection::Clockwise>());
+			break;
+		case EPointDirection::CounterClockwise:
+			Function(TIntegralConstant<EPointDirection, EPointDirection::CounterClockwise>());
+			break;
+		case EPointDirection::Inside:
+			Function(TIntegralConstant<EPointDirection, EPointDirection::Inside>());
+			break;
+		case EPointDirection::Outside:
+			Function(TIntegralConstant<EPointDirection, EPointDirection::Outside>());
+			break;
+		}
+	}
+
+	/** Amount of points generated between two exact sine and cosine evaluations of the circle kernel. */
+	constexpr int32 CircleKernelBlockSize = 64;
+
+	/** Radius of every point of a ring or an arc. */
+	struct FConstantRadius
+	{
+		VectorRegister4Float Radius;
+
+		VectorRegister4Float operator()(const VectorRegister4Float& PointIndices) const
+		{
+			return Radius;
+		}
+	};
+
+	/** Radius of sunflower points which grows with a square root of the point index. */
+	struct FSunFlowerRadius
+	{
+		VectorRegister4Float Radius;
+		VectorRegister4Float InvPointsAmount;
+
+		VectorRegister4Float operator()(const VectorRegister4Float& PointIndices) const
+		{
+			return VectorMultiply(Radius, VectorSqrt(VectorMultiply(PointIndices, InvPointsAmount)));
+		}
+	};
+
+	/** Checks if the circle kernel can be used with the given frame. */
+	bool HasUniformPositiveScale(const FTransform& Frame)
+	{
+		const FVector Scale = Frame.GetScale3D();
+		return Scale.AllComponentsEqual() && Scale.X > 0.f;
+	}
+
+	/** Returns a yaw offset which turns an outward facing point to the given direction. */
+	constexpr float GetDirectionYawOffset(const EPointDirection Direction)
+	{
+		switch (Direction)
+		{
+		case EPointDirection::Clockwise:
+			return HALF_PI;
+		case EPointDirection::CounterClockwise:
+			return -HALF_PI;
+		case EPointDirection::Inside:
+			return PI;
+		default:
+			return 0.f;
+		}
+	}
+
+	/**
+	 * Writes points placed around the Frame location in its XY plane at angles Step * i.
+	 * Half angle sines and cosines are advanced four points at a time with a rotation recurrence
+	 * and re-seeded with exact values every CircleKernelBlockSize points, which keeps the accumulated error
+	 * within a few float ulps. Point rotations are built directly as Frame * Yaw(Angle + DirectionOffset),
+	 * so Frame must have a uniform scale.
+	 */
+	template <EPointDirection Direction, typename WriterType, typename RadiusFunctionType>
+	void WriteCirclePoints(const FTransform& Frame,
+	                       const int32 PointsAmount,
+	                       const float Step,
+	                       const RadiusFunctionType& RadiusFunction,
+	                       WriterType& Writer,
+	                       const int32 StartIndex)
+	{
+		const FQuat FrameRotation = Frame.GetRotation();
+		const FVector FrameLocation = Frame.GetLocation();
+		const FVector FrameScale = Frame.GetScale3D();
+		const FVector AxisX = FrameRotation.GetForwardVector() * FrameScale.X;
+		const FVector AxisY = FrameRotation.GetRightVector() * FrameScale.X;
+
+		const FQuat BaseRotation = FrameRotation * FQuat(FVector::UpVector, GetDirectionYawOffset(Direction));
+		const VectorRegister4Float BaseX = VectorSetFloat1(static_cast<float>(BaseRotation.X));
+		const VectorRegister4Float BaseY = VectorSetFloat1(static_cast<float>(BaseRotation.Y));
+		const VectorRegister4Float BaseZ = VectorSetFloat1(static_cast<float>(BaseRotation.Z));
+		const VectorRegister4Float BaseW = VectorSetFloat1(static_cast<float>(BaseRotation.W));
+
+		const float HalfStep = Step * 0.5f;
+		float BatchSin = 0.f;
+		float BatchCos = 0.f;
+		FMath::SinCos(&BatchSin, &BatchCos, HalfStep * 4.f);
+		const VectorRegister4Float BatchSinVec = VectorSetFloat1(BatchSin);
+		const VectorRegister4Float BatchCosVec = VectorSetFloat1(BatchCos);
+		const VectorRegister4Float LaneOffsets = MakeVectorRegisterFloat(0.f, 1.f, 2.f, 3.f);
+		const VectorRegister4Float Two = VectorSetFloat1(2.f);
+
+		alignas(16) float HalfSinValues[4];
+		alignas(16) float HalfCosValues[4];
+		alignas(16) float OffsetsX[4];
+		alignas(16) float OffsetsY[4];
+		alignas(16) float RotationsX[4];
+		alignas(16) float RotationsY[4];
+		alignas(16) float RotationsZ[4];
+		alignas(16) float RotationsW[4];
+
+		for (int32 BlockStart = 0; BlockStart < PointsAmount; BlockStart += CircleKernelBlockSize)
+		{
+			for (int32 Lane = 0; Lane < 4; ++Lane)
+			{
+				FMath::SinCos(&HalfSinValues[Lane], &HalfCosValues[Lane], HalfStep * (BlockStart + Lane));
+			}
+
+			VectorRegister4Float HalfSin = VectorLoadAligned(HalfSinValues);
+			VectorRegister4Float HalfCos = VectorLoadAligned(HalfCosValues);
+			const int32 BlockEnd = FMath::Min(BlockStart + CircleKernelBlockSize, PointsAmount);
+
+			for (int32 BatchStart = BlockStart; BatchStart < BlockEnd; BatchStart += 4)
+			{
+				const VectorRegister4Float Cos = VectorNegateMultiplyAdd(HalfSin,
+				                                                         HalfSin,
+				                                                         VectorMultiply(HalfCos, HalfCos));
+				const VectorRegister4Float Sin = VectorMultiply(Two, VectorMultiply(HalfSin, HalfCos));
+				const VectorRegister4Float PointIndices = VectorAdd(VectorSetFloat1(static_cast<float>(BatchStart)),
+				                                                    LaneOffsets);
+				const VectorRegister4Float Radius = RadiusFunction(PointIndices);
+				VectorStoreAligned(VectorMultiply(Radius, Cos), OffsetsX);
+				VectorStoreAligned(VectorMultiply(Radius, Sin), OffsetsY);
+
+				const int32 LanesAmount = FMath::Min(4, BlockEnd - BatchStart);
+
+				if constexpr (Direction == EPointDirection::Origin)
+				{
+					for (int32 Lane = 0; Lane < LanesAmount; ++Lane)
+					{
+						const FVector Location = FrameLocation + AxisX * OffsetsX[Lane] + AxisY * OffsetsY[Lane];
+						Writer.SetPoint(StartIndex + BatchStart + Lane, Location, FrameRotation, FrameScale);
+					}
+				}
+				else
+				{
+					// BaseRotation * (0, 0, HalfSin, HalfCos)
+					const VectorRegister4Float QuatX = VectorMultiplyAdd(BaseY, HalfSin, VectorMultiply(BaseX, HalfCos));
+					const VectorRegister4Float QuatY = VectorNegateMultiplyAdd(BaseX, HalfSin, VectorMultiply(BaseY, HalfCos));
+					const VectorRegister4Float QuatZ = VectorMultiplyAdd(BaseW, HalfSin, VectorMultiply(BaseZ, HalfCos));
+					const VectorRegister4Float QuatW = VectorNegateMultiplyAdd(BaseZ, HalfSin, VectorMultiply(BaseW, HalfCos));
+					VectorStoreAligned(QuatX, RotationsX);
+					VectorStoreAligned(QuatY, RotationsY);
+					VectorStoreAligned(QuatZ, RotationsZ);
+					VectorStoreAligned(QuatW, RotationsW);
+
+					for (int32 Lane = 0; Lane < LanesAmount; ++Lane)
+					{
+						const FVector Location = FrameLocation + AxisX * OffsetsX[Lane] + AxisY * OffsetsY[Lane];
+						const FQuat Rotation(RotationsX[Lane], RotationsY[Lane], RotationsZ[Lane], RotationsW[Lane]);
+						Writer.SetPoint(StartIndex + BatchStart + Lane, Location, Rotation, FrameScale);
+					}
+				}
+
+				const VectorRegister4Float NextHalfSin = VectorMultiplyAdd(HalfSin,
+				                                                           BatchCosVec,
+				                                                           VectorMultiply(HalfCos, BatchSinVec));
+				HalfCos = VectorNegateMultiplyAdd(HalfSin, BatchSinVec, VectorMultiply(HalfCos, BatchCosVec));
+				HalfSin = NextHalfSin;
+			}
+		}
+	}
+
+	template <typename WriterType>
+	void GenerateGrid(const FTransform& Origin,
+	                  const int32 SizeX,
+	                  const int32 SizeY,
+	                  const FVector2D& CellSize,
+	                  WriterType& Writer)
+	{
+		if (SizeX <= 0 || SizeY <= 0 || CellSize.X <= 0.f || CellSize.Y <= 0.f)
+		{
+			return;
+		}
+
+		const FQuat OriginRotation = Origin.GetRotation();
+		const FVector OriginLocation = Origin.GetLocation();
+		const FVector OriginScale = Origin.GetScale3D();
+		const FVector OriginFwdVec = OriginRotation.GetForwardVector();
+		const FVector OriginRightVec = OriginRotation.GetRightVector();
+
+		const int32 StartIndex = Writer.AddPoints(SizeX * SizeY);
+
+		ForEachPointRange(SizeX * SizeY, [&](const int32 RangeStart, const int32 RangeEnd)
+		{
+			for (int32 i = RangeStart; i < RangeEnd; ++i)
+			{
+				const int32 x = i / SizeY;
+				const int32 y = i % SizeY;
+
+				FVector NewLocation = FVector::ZeroVector;
+				NewLocation += x * CellSize.X * OriginFwdVec;
+				NewLocation += y * CellSize.Y * OriginRightVec;
+				Writer.SetPoint(StartIndex + i, OriginLocation + NewLocation, OriginRotation, OriginScale);
+			}
+		});
+	}
+
+	template <typename WriterType>
+	void GenerateCube(const FTransform& Origin,
+	                  const int32 SizeX,
+	                  const int32 SizeY,
+	                  const int32 SizeZ,
+	                  const FVector& CellSize,
+	                  WriterType& Writer)
+	{
+		if (SizeX <= 0 || SizeY <= 0 || SizeZ <= 0 || CellSize.X <= 0.f || CellSize.Y <= 0.f || CellSize.Z <= 0.f)
+		{
+			return;
+		}
+
+		const FQuat OriginRotation = Origin.GetRotation();
+		const FVector OriginLocation = Origin.GetLocation();
+		const FVector OriginScale = Origin.GetScale3D();
+		const FVector OriginFwdVec = OriginRotation.GetForwardVector();
+		const FVector OriginRightVec = OriginRotation.GetRightVector();
+		const FVector OriginUpVec = OriginRotation.GetUpVector();
+
+		const int32 LayerSize = SizeY * SizeZ;
+		const int32 StartIndex = Writer.AddPoints(SizeX * LayerSize);
+
+		ForEachPointRange(SizeX * LayerSize, [&](const int32 RangeStart, const int32 RangeEnd)
+		{
+			for (int32 i = RangeStart; i < RangeEnd; ++i)
+			{
+				const int32 x = i / LayerSize;
+				const int32 y = (i % LayerSize) / SizeZ;
+				const int32 z = i % SizeZ;
+
+				FVector NewLocation = FVector::ZeroVector;
+				NewLocation += x * CellSize.X * OriginFwdVec;
+				NewLocation += y * CellSize.Y * OriginRightVec;
+				NewLocation += z * CellSize.Z * OriginUpVec;
+				Writer.SetPoint(StartIndex + i, OriginLocation + NewLocation, OriginRotation, OriginScale);
+			}
+		});
+	}
+
+	/** Calculates the amount of points in a ring or an arc of the dynamic concentric patterns. */
+	int32 CalculateDynamicPointsAmount(const int32 Index,
+	                                   const int32 MinPoints,
+	                                   const int32 MaxPoints,
+	                                   const float MinRadius,
+	                                   const float Radius)
+	{
+		if (Index > 0 && MinRadius > 0.f)
+		{
+			const float CircumferenceRatio = Radius / MinRadius;
+			return FMath::Clamp(FMath::RoundToInt(MinPoints * CircumferenceRatio), MinPoints, MaxPoints);
+		}
+
+		return MinPoints;
+	}
+
+	/** Writes ring points into already allocated writer slots starting from StartIndex. */
+	template <EPointDirection Direction, typename WriterType>
+	void WriteRingPoints(const FTransform& Origin,
+	                     const int32 PointsAmount,
+	                     const float Radius,
+	                     WriterType& Writer,
+	                     const int32 StartIndex)
+	{
+		const float Theta = (2.f * PI) / PointsAmount;
+
+		if (HasUniformPositiveScale(Origin))
+		{
+			const FConstantRadius RadiusFunction{VectorSetFloat1(Radius)};
+			WriteCirclePoints<Direction>(Origin, PointsAmount, Theta, RadiusFunction, Writer, StartIndex);
+			return;
+		}
+
+		const TPointRotationSolver<Direction> RotationSolver(Origin);
+
+		for (int32 i = 0; i < PointsAmount; ++i)
+		{
+			const float Angle = Theta * i;
+			FVector NewLocation = FVector::ZeroVector;
+			NewLocation.X = Radius * FMath::Cos(Angle);
+			NewLocation.Y = Radius * FMath::Sin(Angle);
+			FTransform NewTransform(NewLocation);
+			NewTransform *= Origin;
+
+			NewTransform.SetRotation(RotationSolver(NewTransform.GetLocation()));
+
+			Writer.SetPoint(StartIndex + i, NewTransform);
+		}
+	}
+
+	template <EPointDirection Direction, typename WriterType>
+	void GenerateRing(const FTransform& Origin,
+	                  const int32 PointsAmount,
+	                  const float Radius,
+	                  WriterType& Writer)
+	{
+		if (PointsAmount <= 0 || Radius < 0.f)
+		{
+			return;
+		}
+
+		const int32 StartIndex = Writer.AddPoints(PointsAmount);
+		WriteRingPoints<Direction>(Origin, PointsAmount, Radius, Writer, StartIndex);
+	}
+
+	template <EPointDirection Direction, typename WriterType>
+	void GenerateConcentricRings(const FTransform& Origin,
+	                             const int32 RingsAmount,
+	                             const int32 PointsPerRing,
+	                             const float MinRadius,
+	                             const float MaxRadius,
+	                             const float RingDeltaAngle,
+	                             WriterType& Writer)
+	{
+		if (RingsAmount <= 0 || PointsPerRing <= 0 || MinRadius < 0.f || MaxRadius <= MinRadius)
+		{
+			return;
+		}
+
+		const float RadiusStep = (MaxRadius - MinRadius) / (RingsAmount - 1);
+		FTransform RingOrigin = Origin;
+		const FVector OriginFwdVector = RingOrigin.GetRotation().GetForwardVector();
+		const FVector OriginUpVector = RingOrigin.GetRotation().GetUpVector();
+
+		int32 PointIndex = Writer.AddPoints(RingsAmount * PointsPerRing);
+
+		for (int32 i = 0; i < RingsAmount; ++i)
+		{
+			const FVector XAxis = OriginFwdVector.RotateAngleAxis(RingDeltaAngle * i, OriginUpVector);
+			RingOrigin.SetRotation(FRotationMatrix::MakeFromXZ(XAxis, OriginUpVector).ToQuat());
+
+			const float RingRadius = MinRadius + RadiusStep * i;
+			WriteRingPoints<Direction>(RingOrigin, PointsPerRing, RingRadius, Writer, PointIndex);
+			PointIndex += PointsPerRing;
+		}
+	}
+
+	template <EPointDirection Direction, typename WriterType>
+	void GenerateDynamicConcentricRings(const FTransform& Origin,
+	                                    const int32 RingsAmount,
+	                                    const int32 MinPoints,
+	                                    const int32 MaxPoints,
+	                                    const float MinRadius,
+	                                    const float MaxRadius,
+	                                    const float RingDeltaAngle,
+	                                    WriterType& Writer)
+	{
+		if (RingsAmount <= 0 || MinPoints <= 0 || MaxPoints <= MinPoints || MinRadius < 0.f || MaxRadius <= MinRadius)
+		{
+			return;
+		}
+
+		const float RadiusStep = (MaxRadius - MinRadius) / (RingsAmount - 1);
+		FTransform RingOrigin = Origin;
+		const FVector OriginFwdVector = RingOrigin.GetRotation().GetForwardVector();
+		const FVector OriginUpVector = RingOrigin.GetRotation().GetUpVector();
+
+		int32 TotalPoints = 0;
+
+		for (int32 i = 0; i < RingsAmount; ++i)
+		{
+			const float RingRadius = MinRadius + RadiusStep * i;
+			TotalPoints += CalculateDynamicPointsAmount(i, MinPoints, MaxPoints, MinRadius, RingRadius);
+		}
+
+		int32 PointIndex = Writer.AddPoints(TotalPoints);
+
+		for (int32 i = 0; i < RingsAmount; ++i)
+		{
+			const FVector XAxis = OriginFwdVector.RotateAngleAxis(RingDeltaAngle * i, OriginUpVector);
+			RingOrigin.SetRotation(FRotationMatrix::MakeFromXZ(XAxis, OriginUpVector).ToQuat());
+
+			const float RingRadius = MinRadius + RadiusStep * i;
+			const int32 PointsAmount = CalculateDynamicPointsAmount(i, MinPoints, MaxPoints, MinRadius, RingRadius);
+			WriteRingPoints<Direction>(RingOrigin, PointsAmount, RingRadius, Writer, PointIndex);
+			PointIndex += PointsAmount;
+		}
+	}
+
+	template <EPointDirection Direction, typename WriterType>
+	void GenerateCylinder(const FTransform& Origin,
+	                      const int32 RingsAmount,
+	                      const int32 PointsPerRing,
+	                      const float Radius,
+	                      const float Height,
+	                      const float RingDeltaAngle,
+	                      WriterType& Writer)
+	{
+		if (RingsAmount <= 0 || PointsPerRing <= 0 || Radius < 0.f || Height < 0.f)
+		{
+			return;
+		}
+
+		FTransform RingOrigin = Origin;
+		const FVector OriginLocation = RingOrigin.GetLocation();
+		const FVector OriginFwdVector = RingOrigin.GetRotation().GetForwardVector();
+		const FVector OriginUpVector = RingOrigin.GetRotation().GetUpVector();
+		const float RingDisplacement = Height / (RingsAmount - 1);
+
+		int32 PointIndex = Writer.AddPoints(RingsAmount * PointsPerRing);
+
+		for (int32 i = 0; i < RingsAmount; ++i)
+		{
+			RingOrigin.SetLocation(OriginLocation + OriginUpVector * RingDisplacement * i);
+			const FVector XAxis = OriginFwdVector.RotateAngleAxis(RingDeltaAngle * i, OriginUpVector);
+			RingOrigin.SetRotation(FRotationMatrix::MakeFromXZ(XAxis, OriginUpVector).ToQuat());
+
+			WriteRingPoints<Direction>(RingOrigin, PointsPerRing, Radius, Writer, PointIndex);
+			PointIndex += PointsPerRing;
+		}
+	}
+
+	/** Writes arc points into already allocated writer slots starting from StartIndex. */
+	template <EPointDirection Direction, typename WriterType>
+	void WriteArcPoints(const FTransform& Origin,
+	                    const int32 PointsAmount,
+	                    const float Radius,
+	                    const float AngleDeg,
+	                    WriterType& Writer,
+	                    const int32 StartIndex)
+	{
+		const float AngleRad = UKismetMathLibrary::DegreesToRadians(AngleDeg);
+		const float Theta = PointsAmount > 1 ? AngleRad / (PointsAmount - 1) : 0.f;
+
+		FTransform ArcOrigin = Origin;
+		const FVector OriginFwdVector = ArcOrigin.GetRotation().GetForwardVector();
+		const FVector OriginUpVector = Origin.GetRotation().GetUpVector();
+
+		const FVector XAxis = OriginFwdVector.RotateAngleAxis(-AngleDeg * 0.5f, OriginUpVector);
+		ArcOrigin.SetRotation(FRotationMatrix::MakeFromXZ(XAxis, OriginUpVector).ToQuat());
+
+		if (HasUniformPositiveScale(ArcOrigin))
+		{
+			const FConstantRadius RadiusFunction{VectorSetFloat1(Radius)};
+			WriteCirclePoints<Direction>(ArcOrigin, PointsAmount, Theta, RadiusFunction, Writer, StartIndex);
+			return;
+		}
+
+		const TPointRotationSolver<Direction> RotationSolver(ArcOrigin);
+
+		for (int32 i = 0; i < PointsAmount; ++i)
+		{
+			const float Angle = Theta * i;
+			FVector NewLocation = FVector::ZeroVector;
+			NewLocation.X = Radius * FMath::Cos(Angle);
+			NewLocation.Y = Radius * FMath::Sin(Angle);
+			FTransform NewTransform(NewLocation);
+			NewTransform *= ArcOrigin;
+
+			NewTransform.SetRotation(RotationSolver(NewTransform.GetLocation()));
+
+			Writer.SetPoint(StartIndex + i, NewTransform);
+		}
+	}
+
+	template <EPointDirection Direction, typename WriterType>
+	void GenerateArc(const FTransform& Origin,
+	                 const int32 PointsAmount,
+	                 const float Radius,
+	                 const float AngleDeg,
+	                 WriterType& Writer)
+	{
+		if (PointsAmount <= 0 || Radius < 0.f || AngleDeg < 0.f)
+		{
+			return;
+		}
+
+		const int32 StartIndex = Writer.AddPoints(PointsAmount);
+		WriteArcPoints<Direction>(Origin, PointsAmount, Radius, AngleDeg, Writer, StartIndex);
+	}
+
+	template <EPointDirection Direction, typename WriterType>
+	void GenerateConcentricArcs(const FTransform& Origin,
+	                            const int32 ArcsAmount,
+	                            const int32 PointsPerArc,
+	                            const float MinRadius,
+	                            const float MaxRadius,
+	                            const float AngleDeg,
+	                            WriterType& Writer)
+	{
+		if (ArcsAmount <= 0 || PointsPerArc <= 0 || MinRadius < 0.f || MaxRadius <= MinRadius || AngleDeg < 0.f)
+		{
+			return;
+		}
+
+		const float RadiusStep = (MaxRadius - MinRadius) / (ArcsAmount - 1);
+		int32 PointIndex = Writer.AddPoints(ArcsAmount * PointsPerArc);
+
+		for (int32 i = 0; i < ArcsAmount; ++i)
+		{
+			const float ArcRadius = MinRadius + RadiusStep * i;
+			WriteArcPoints<Direction>(Origin, PointsPerArc, ArcRadius, AngleDeg, Writer, PointIndex);
+			PointIndex += PointsPerArc;
+		}
+	}
+
+	template <EPointDirection Direction, typename WriterType>
+	void GenerateDynamicConcentricArcs(const FTransform& Origin,
+	                                   const int32 ArcsAmount,
+	                                   const int32 MinPoints,
+	                                   const int32 MaxPoints,
+	                                   const float MinRadius,
+	                                   const float MaxRadius,
+	                                   const float AngleDeg,
+	                                   WriterType& Writer)
+	{
+		if (ArcsAmount <= 0 || MinPoints <= 0 || MaxPoints <= MinPoints || MinRadius < 0.f || MaxRadius <= MinRadius
+			|| AngleDeg < 0.f)
+		{
+			return;
+		}
+
+		const float RadiusStep = (MaxRadius - MinRadius) / (ArcsAmount - 1);
+		int32 TotalPoints = 0;
+
+		for (int32 i = 0; i < ArcsAmount; ++i)
+		{
+			const float ArcRadius = MinRadius + RadiusStep * i;
+			TotalPoints += CalculateDynamicPointsAmount(i, MinPoints, MaxPoints, MinRadius, ArcRadius);
+		}
+
+		int32 PointIndex = Writer.AddPoints(TotalPoints);
+
+		for (int32 i = 0; i < ArcsAmount; ++i)
+		{
+			const float ArcRadius = MinRadius + RadiusStep * i;
+			const int32 PointsAmount = CalculateDynamicPointsAmount(i, MinPoints, MaxPoints, MinRadius, ArcRadius);
+			WriteArcPoints<Direction>(Origin, PointsAmount, ArcRadius, AngleDeg, Writer, PointIndex);
+			PointIndex += PointsAmount;
+		}
+	}
+
+	template <EPointDirection Direction, typename WriterType>
+	void GenerateArcCylinder(const FTransform& Origin,
+	                         const int32 ArcsAmount,
+	                         const int32 PointsPerArc,
+	                         const float Radius,
+	                         const float Height,
+	                         const float AngleDeg,
+	                         WriterType& Writer)
+	{
+		if (ArcsAmount <= 0 || PointsPerArc <= 0 || Radius < 0.f || Height < 0.f || AngleDeg < 0.f)
+		{
+			return;
+		}
+
+		FTransform ArcOrigin = Origin;
+		const FVector OriginLocation = ArcOrigin.GetLocation();
+		const FVector OriginUpVector = ArcOrigin.GetRotation().GetUpVector();
+		const float ArcDisplacement = Height / (ArcsAmount - 1);
+
+		int32 PointIndex = Writer.AddPoints(ArcsAmount * PointsPerArc);
+
+		for (int32 i = 0; i < ArcsAmount; ++i)
+		{
+			ArcOrigin.SetLocation(OriginLocation + OriginUpVector * ArcDisplacement * i);
+			WriteArcPoints<Direction>(ArcOrigin, PointsPerArc, Radius, AngleDeg, Writer, PointIndex);
+			PointIndex += PointsPerArc;
+		}
+	}
+
+	template <EPointDirection Direction, typename WriterType>
+	void GenerateSphere(const FTransform& Origin,
+	                    const float Radius,
+	                    const int32 PointsAmount,
+	                    const float MinLatitude,
+	                    const float MaxLatitude,
+	                    const float MinLongitude,
+	                    const float MaxLongitude,
+	                    WriterType& Writer)
+	{
+		if (PointsAmount <= 0 || Radius < 0.f)
+		{
+			return;
+		}
+
+		const float Phi = PI * (3.f - FMath::Sqrt(5.f));
+		constexpr float Tau = PI * 2;
+
+		const float MinLongitudeAngle = MinLongitude * 360.f;
+		const float MaxLongitudeAngle = MaxLongitude * 360.f;
+		const float MinLongitudeRad = FMath::DegreesToRadians(MinLongitudeAngle);
+		const float MaxLongitudeRad = FMath::DegreesToRadians(MaxLongitudeAngle);
+
+		const int32 StartIndex = Writer.AddPoints(PointsAmount);
+		const TPointRotationSolver<Direction> RotationSolver(Origin);
+		FTransform NewTransform = FTransform::Identity;
+
+		for (int32 i = 0; i < PointsAmount; ++i)
+		{
+			const float Z = ((i / (static_cast<float>(PointsAmount) - 1.f)) * (MaxLatitude - MinLatitude) + MinLatitude) *
+				2.f - 1.f;
+			const float RadiusZ = FMath::Sqrt(1.f - Z * Z);
+			float Theta = Phi * static_cast<float>(i);
+
+			if (MinLongitudeAngle != 0.f || MaxLongitudeAngle != 360.f)
+			{
+				Theta = FMath::Fmod(Theta, Tau);
+				Theta = Theta < 0 ? Theta + Tau : Theta;
+				Theta = Theta * MaxLongitudeRad / Tau + MinLongitudeRad;
+			}
+
+			const float X = FMath::Sin(Theta) * RadiusZ;
+			const float Y = FMath::Cos(Theta) * RadiusZ;
+
+			FVector Location{X, Y, Z};
+			Location *= Radius;
+			Location = Origin.TransformPosition(Location);
+			NewTransform.SetLocation(Location);
+
+			NewTransform.SetRotation(RotationSolver(NewTransform.GetLocation()));
+
+			Writer.SetPoint(StartIndex + i, NewTransform);
+		}
+	}
+
+	template <EPointDirection Direction, typename WriterType>
+	void GenerateSunFlower(const FTransform& Origin,
+	                       const float Radius,
+	                       const int32 PointsAmount,
+	                       WriterType& Writer)
+	{
+		if (PointsAmount <= 0 || Radius < 0.f)
+		{
+			return;
+		}
+
+		const float GoldenAngle = PI * (3.0f - FMath::Sqrt(5.0f));
+		const int32 StartIndex = Writer.AddPoints(PointsAmount);
+
+		if (HasUniformPositiveScale(Origin))
+		{
+			const FSunFlowerRadius RadiusFunction{
+				VectorSetFloat1(Radius),
+				VectorSetFloat1(1.f / static_cast<float>(PointsAmount))
+			};
+			WriteCirclePoints<Direction>(Origin, PointsAmount, GoldenAngle, RadiusFunction, Writer, StartIndex);
+			return;
+		}
+
+		const TPointRotationSolver<Direction> RotationSolver(Origin);
+
+		for (int32 i = 0; i < PointsAmount; ++i)
+		{
+			const float PointRadius = Radius * FMath::Sqrt(static_cast<float>(i) / static_cast<float>(PointsAmount));
+			const float Angle = i * GoldenAngle;
+
+			FVector NewLocation = FVector::ZeroVector;
+			NewLocation.X = PointRadius * FMath::Cos(Angle);
+			NewLocation.Y = PointRadius * FMath::Sin(Angle);
+			FTransform NewTransform(NewLocation);
+			NewTransform *= Origin;
+
+			NewTransform.SetRotation(RotationSolver(NewTransform.GetLocation()));
+
+			Writer.SetPoint(StartIndex + i, NewTransform);
+		}
+	}
+
+	/**
+	 * Writes the local pattern moved to every origin into Destination, one origin after another.
+	 * The work is split over the flattened point range, so both many small and a few big patterns use all workers.
+	 */
+	void StampPatternAtOrigins(const TArray<FTransform>& LocalTransforms,
+	                           const TArray<FTransform>& Origins,
+	                           FTransform* Destination)
+	{
+		const int32 PatternSize = LocalTransforms.Num();
+
+		if (PatternSize == 0)
+		{
+			return;
+		}
+
+		const FTransform* Source = LocalTransforms.GetData();
+		const FTransform* OriginsData = Origins.GetData();
+
+		ForEachPointRange(PatternSize * Origins.Num(), [&](const int32 RangeStart, const int32 RangeEnd)
+		{
+			int32 OriginIndex = RangeStart / PatternSize;
+			int32 PointIndex = RangeStart - OriginIndex * PatternSize;
+
+			for (int32 i = RangeStart; i < RangeEnd; ++i)
+			{
+				FTransform::Multiply(Destination + i, Source + PointIndex, OriginsData + OriginIndex);
+
+				if (++PointIndex == PatternSize)
+				{
+					PointIndex = 0;
+					++OriginIndex;
+				}
+			}
+		});
+	}
+
+	/** Calls the library generator which matches the pattern type of the settings. */
+	template <typename OutputType>
+	void CalculatePattern(const FTransform& Origin, const FTrickyPatternSettings& Settings, OutputType& Output)
+	{
+		switch (Settings.PatternType)
+		{
+		case EPatternType::Grid:
+			UTrickyUtilityLibrary::CalculateGridTransforms(Origin,
+			                                               Settings.GridSize.X,
+			                                               Settings.GridSize.Y,
+			                                               FVector2D(Settings.CellSize),
+			                                               Output);
+			break;
+		case EPatternType::Cube:
+			UTrickyUtilityLibrary::CalculateCubeTransforms(Origin,
+			                                               Settings.GridSize.X,
+			                                               Settings.GridSize.Y,
+			                                               Settings.GridSize.Z,
+			                                               Settings.CellSize,
+			                                               Output);
+			break;
+		case EPatternType::Ring:
+			UTrickyUtilityLibrary::CalculateRingTransform(Origin,
+			                                              Settings.PointsAmount,
+			                                              Settings.Radius,
+			                                              Settings.Direction,
+			                                              Output);
+			break;
+		case EPatternType::ConcentricRings:
+			UTrickyUtilityLibrary::CalculateConcentricRingsTransforms(Origin,
+			                                                          Settings.RingsAmount,
+			                                                          Settings.PointsAmount,
+			                                                          Settings.MinRadius,
+			                                                          Settings.MaxRadius,
+			                                                          Settings.RingDeltaAngle,
+			                                                          Settings.Direction,
+			                                                          Output);
+			break;
+		case EPatternType::DynamicConcentricRings:
+			UTrickyUtilityLibrary::CalculateDynamicConcentricRingsTransforms(Origin,
+			                                                                 Settings.RingsAmount,
+			                                                                 Settings.MinPoints,
+			                                                                 Settings.MaxPoints,
+			                                                                 Settings.MinRadius,
+			                                                                 Settings.MaxRadius,
+			                                                                 Settings.RingDeltaAngle,
+			                                                                 Settings.Direction,
+			                                                                 Output);
+			break;
+		case EPatternType::Cylinder:
+			UTrickyUtilityLibrary::CalculateCylinderTransforms(Origin,
+			                                                   Settings.RingsAmount,
+			                                                   Settings.PointsAmount,
+			                                                   Settings.Radius,
+			                                                   Settings.Height,
+			                                                   Settings.RingDeltaAngle,
+			                                                   Settings.Direction,
+			                                                   Output);
+			break;
+		case EPatternType::Arc:
+			UTrickyUtilityLibrary::CalculateArcTransforms(Origin,
+			                                              Settings.PointsAmount,
+			                                              Settings.Radius,
+			                                              Settings.AngleDeg,
+			                                              Settings.Direction,
+			                                              Output);
+			break;
+		case EPatternType::ConcentricArcs:
+			UTrickyUtilityLibrary::CalculateConcentricArcsTransforms(Origin,
+			                                                         Settings.RingsAmount,
+			                                                         Settings.PointsAmount,
+			                                                         Settings.MinRadius,
+			                                                         Settings.MaxRadius,
+			                                                         Settings.AngleDeg,
+			                                                         Settings.Direction,
+			                                                         Output);
+			break;
+		case EPatternType::DynamicConcentricArcs:
+			UTrickyUtilityLibrary::CalculateDynamicConcentricArcsTransforms(Origin,
+			                                                                Settings.RingsAmount,
+			                                                                Settings.MinPoints,
+			                                                                Settings.MaxPoints,
+			                                                                Settings.MinRadius,
+			                                                                Settings.MaxRadius,
+			                                                                Settings.AngleDeg,
+			                                                                Settings.Direction,
+			                                                                Output);
+			break;
+		case EPatternType::ArcCylinder:
+			UTrickyUtilityLibrary::CalculateArcCylinderTransforms(Origin,
+			                                                      Settings.RingsAmount,
+			                                                      Settings.PointsAmount,
+			                                                      Settings.Radius,
+			                                                      Settings.Height,
+			                                                      Settings.AngleDeg,
+			                                                      Settings.Direction,
+			                                                      Output);
+			break;
+		case EPatternType::Sphere:
+			UTrickyUtilityLibrary::CalculateSphereTransforms(Origin,
+			                                                 Settings.Radius,
+			                                                 Settings.PointsAmount,
+			                                                 Settings.Latitude.X,
+			                                                 Settings.Latitude.Y,
+			                                                 Settings.Longitude.X,
+			                                                 Settings.Longitude.Y,
+			                                                 Settings.Direction,
+			                                                 Output);
+			break;
+		case EPatternType::SunFlower:
+			UTrickyUtilityLibrary::CalculateSunFlowerTransforms(Origin,
+			                                                    Settings.Radius,
+			                                                    Settings.PointsAmount,
+			                                                    Settings.Direction,
+			                                                    Output);
+			break;
+		}
+	}
+
+	int32 GetSplinePointsAmountByDistance(const float SplineLength, const float Distance)
+	{
+		return FMath::Max(0, FMath::CeilToInt32(SplineLength / Distance));
+	}
+
+	/** Fills the given transforms with points evenly distributed along the whole spline. */
+	void SampleTransformsByPoints(FTrickySplineSampler& Sampler,
+	                              const ESplineCoordinateSpace::Type CoordinateSpace,
+	                              const TArrayView<FTransform> OutTransforms)
+	{
+		const int32 PointsAmount = OutTransforms.Num();
+		const float Displacement = PointsAmount > 1 ? Sampler.GetSplineLength() / (PointsAmount - 1) : 0.f;
+
+		for (int32 i = 0; i < PointsAmount; ++i)
+		{
+			const float Distance = Displacement * i;
+			OutTransforms[i] = Sampler.GetTransformAtDistance(Distance, CoordinateSpace);
+		}
+	}
+
+	/** Fills the given transforms with points placed in the middle of every Distance long piece of the spline. */
+	void SampleTransformsByDistance(FTrickySplineSampler& Sampler,
+	                                const float Distance,
+	                                const ESplineCoordinateSpace::Type CoordinateSpace,
+	                                const TArrayView<FTransform> OutTransforms)
+	{
+		const float HalfDistance = Distance * 0.5f;
+
+		for (int32 i = 0; i < OutTransforms.Num(); ++i)
+		{
+			const float SplineDistance = (Distance * i) + HalfDistance;
+			OutTransforms[i] = Sampler.GetTransformAtDistance(SplineDistance, CoordinateSpace);
+		}
+	}
+
+	/**
+	 * Smallest MinDistance of curvature sampling relative to the spline length.
+	 * Shorter steps get lost in the float precision of distances along long splines.
+	 */
+	constexpr double MinRelativeCurvatureStep = 1e-6;
+
+	/**
+	 * Appends transforms spaced by the turning rate of the spline in a single pass from its start to its end.
+	 * The next step is predicted from the turn over MinDistance ahead of the current sample, and shortened once
+	 * if the direction at the predicted sample still turns by more than MaxAngle.
+	 */
+	void SampleTransformsByCurvature(FTrickySplineSampler& Sampler,
+	                                 const float MinDistance,
+	                                 const float MaxDistance,
+	                                 const float MaxAngle,
+	                                 const ESplineCoordinateSpace::Type CoordinateSpace,
+	                                 TArray<FTransform>& OutTransforms)
+	{
+		// Distances are accumulated in double, so the walk keeps moving forward on long splines.
+		const double SplineLength = Sampler.GetSplineLength();
+		const double MaxAngleRad = FMath::DegreesToRadians(MaxAngle);
+
+		auto GetAngleBetween = [](const FVector& A, const FVector& B)
+		{
+			return FMath::Acos(FMath::Clamp(FVector::DotProduct(A, B), -1.0, 1.0));
+		};
+
+		double Distance = 0.0;
+		FTransform Transform = Sampler.GetTransformAtDistance(0.f, CoordinateSpace);
+		OutTransforms.Emplace(Transform);
+
+		while (Distance < SplineLength)
+		{
+			const FVector Direction = Transform.GetRotation().GetForwardVector();
+			const double LookAheadDistance = FMath::Min(Distance + MinDistance, SplineLength);
+			const FVector LookAheadDirection = Sampler.GetDirectionAtDistance(static_cast<float>(LookAheadDistance),
+			                                                                CoordinateSpace);
+			const double LookAheadAngle = GetAngleBetween(Direction, LookAheadDirection);
+
+			double Step = LookAheadAngle > UE_KINDA_SMALL_NUMBER
+				              ? MinDistance * MaxAngleRad / LookAheadAngle
+				              : MaxDistance;
+			Step = FMath::Clamp<double>(Step, MinDistance, MaxDistance);
+
+			double NextDistance = FMath::Min(Distance + Step, SplineLength);
+			FTransform NextTransform = Sampler.GetTransformAtDistance(static_cast<float>(NextDistance), CoordinateSpace);
+			const double NextAngle = GetAngleBetween(Direction, NextTransform.GetRotation().GetForwardVector());
+
+			if (NextAngle > MaxAngleRad && NextDistance - Distance > MinDistance)
+			{
+				Step = FMath::Max<double>(MinDistance, (NextDistance - Distance) * MaxAngleRad / NextAngle);
+				NextDistance = FMath::Min(Distance + Step, SplineLength);
+				NextTransform = Sampler.GetTransformAtDistance(static_cast<float>(NextDistance), CoordinateSpace);
+			}
+
+			if (NextDistance <= Distance)
+			{
+				// No progress is possible anymore, finish with the end of the spline.
+				OutTransforms.Emplace(Sampler.GetTransformAtDistance(static_cast<float>(SplineLength), CoordinateSpace));
+				break;
+			}
+
+			Distance = NextDistance;
+			Transform = NextTransform;
+			OutTransforms.Emplace(Transform);
+		}
+	}
+
+	/**
+	 * Fills the given frames at uniform distances along the whole spline.
+	 * Frames are rotation minimizing, each one is derived from the previous one by the double reflection method
+	 * (Wang et al., "Computation of Rotation Minimizing Frames", 2008). The first frame uses the spline up vector.
+	 * Z axis of the frames points along the spline.
+	 */
+	void CalculateRotationMinimizingFrames(FTrickySplineSampler& Sampler,
+	                                       const ESplineCoordinateSpace::Type CoordinateSpace,
+	                                       const TArrayView<FTransform> OutFrames)
+	{
+		const int32 FramesAmount = OutFrames.Num();
+		const float Step = FramesAmount > 1 ? Sampler.GetSplineLength() / (FramesAmount - 1) : 0.f;
+
+		const FTransform StartTransform = Sampler.GetTransformAtDistance(0.f, CoordinateSpace);
+		FVector Location = StartTransform.GetLocation();
+		FVector Tangent = StartTransform.GetRotation().GetForwardVector();
+		FVector Reference = StartTransform.GetRotation().GetUpVector();
+		OutFrames[0] = FTransform(FRotationMatrix::MakeFromZX(Tangent, Reference).ToQuat(), Location);
+
+		for (int32 i = 1; i < FramesAmount; ++i)
+		{
+			const float Distance = i == FramesAmount - 1 ? Sampler.GetSplineLength() : Step * i;
+			const FVector NextLocation = Sampler.GetLocationAtDistance(Distance, CoordinateSpace);
+			const FVector NextTangent = Sampler.GetDirectionAtDistance(Distance, CoordinateSpace);
+
+			// Reflect the frame by the bisecting plane of the two locations, then by the one of the tangents.
+			const FVector Offset = NextLocation - Location;
+			const double OffsetSizeSquared = Offset.SizeSquared();
+			FVector ReflectedReference = Reference;
+			FVector ReflectedTangent = Tangent;
+
+			if (OffsetSizeSquared > UE_SMALL_NUMBER)
+			{
+				ReflectedReference -= (2.0 / OffsetSizeSquared) * Offset.Dot(Reference) * Offset;
+				ReflectedTangent -= (2.0 / OffsetSizeSquared) * Offset.Dot(Tangent) * Offset;
+			}
+
+			const FVector TangentDelta = NextTangent - ReflectedTangent;
+			const double TangentDeltaSizeSquared = TangentDelta.SizeSquared();
+
+			if (TangentDeltaSizeSquared > UE_SMALL_NUMBER)
+			{
+				ReflectedReference -= (2.0 / TangentDeltaSizeSquared) * TangentDelta.Dot(ReflectedReference) * TangentDelta;
+			}
+
+			Location = NextLocation;
+			Tangent = NextTangent;
+			Reference = ReflectedReference;
+			OutFrames[i] = FTransform(FRotationMatrix::MakeFromZX(Tangent, Reference).ToQuat(), Location);
+		}
+	}
+
+	/** Appends uninitialized transforms and returns a view of them. */
+	TArrayView<FTransform> AddTransforms(TArray<FTransform>& OutTransforms, const int32 Amount)
+	{
+		const int32 StartIndex = OutTransforms.AddUninitialized(Amount);
+		return TArrayView<FTransform>(OutTransforms.GetData() + StartIndex, Amount);
+	}
+
+	/** Limits subdivision of degenerate segments, 2^16 pieces per segment are far beyond any sensible tolerance. */
+	constexpr int32 MaxSplineBakeDepth = 16;
+
+	/** Evaluates the curve at the given key and moves the location into the space of the baked polyline. */
+	FVector EvalBakedLocation(const FInterpCurveVector& Position, const FTransform& CurveTransform, const float Key)
+	{
+		return CurveTransform.TransformPosition(Position.Eval(Key, FVector::ZeroVector));
+	}
+
+	/**
+	 * Appends points of the curve piece between StartKey and EndKey, excluding its start.
+	 * The piece is split in half while its middle or quarter points deviate from its chord more than the tolerance.
+	 * All locations are in the space given by CurveTransform, so the tolerance is measured in that space.
+	 */
+	void BakeSplinePiece(const FInterpCurveVector& Position,
+	                     const FTransform& CurveTransform,
+	                     const float StartKey,
+	                     const FVector& StartLocation,
+	                     const FVector& MiddleLocation,
+	                     const float EndKey,
+	                     const FVector& EndLocation,
+	                     const double ToleranceSquared,
+	                     const int32 Depth,
+	                     TArray<FVector>& OutLocations)
+	{
+		const float MiddleKey = (StartKey + EndKey) * 0.5f;
+		const FVector FirstQuarterLocation = EvalBakedLocation(Position, CurveTransform, (StartKey + MiddleKey) * 0.5f);
+		const FVector LastQuarterLocation = EvalBakedLocation(Position, CurveTransform, (MiddleKey + EndKey) * 0.5f);
+		const bool bIsWithinTolerance =
+			FMath::PointDistToSegmentSquared(MiddleLocation, StartLocation, EndLocation) <= ToleranceSquared
+			&& FMath::PointDistToSegmentSquared(FirstQuarterLocation, StartLocation, EndLocation) <= ToleranceSquared
+			&& FMath::PointDistToSegmentSquared(LastQuarterLocation, StartLocation, EndLocation) <= ToleranceSquared;
+
+		if (bIsWithinTolerance || Depth >= MaxSplineBakeDepth)
+		{
+			OutLocations.Emplace(EndLocation);
+			return;
+		}
+
+		BakeSplinePiece(Position,
+		                CurveTransform,
+		                StartKey,
+		                StartLocation,
+		                FirstQuarterLocation,
+		                MiddleKey,
+		                MiddleLocation,
+		                ToleranceSquared,
+		                Depth + 1,
+		                OutLocations);
+		BakeSplinePiece(Position,
+		                CurveTransform,
+		                MiddleKey,
+		                MiddleLocation,
+		                LastQuarterLocation,
+		                EndKey,
+		                EndLocation,
+		                ToleranceSquared,
+		                Depth + 1,
+		                OutLocations);
+	}
+
+	/**
+	 * Samples a copy of the spline curves on a background task.
+	 * SampleFunction is called as SampleFunction(Sampler, CoordinateSpace, OutTransforms) and must append the samples.
+	 */
+	template <typename SampleFunctionType>
+	TFuture<TArray<FTransform>> SampleSplineAsync(const USplineComponent& SplineComponent,
+	                                              const bool bUseLocalSpace,
+	                                              SampleFunctionType&& SampleFunction)
+	{
+		const ESplineCoordinateSpace::Type CoordinateSpace = bUseLocalSpace
+			                                                     ? ESplineCoordinateSpace::Local
+			                                                     : ESplineCoordinateSpace::World;
+
+		return Async(EAsyncExecution::TaskGraph,
+		             [SplineCurves = SplineComponent.SplineCurves,
+			             DefaultUpVector = SplineComponent.DefaultUpVector,
+			             ComponentTransform = SplineComponent.GetComponentTransform(),
+			             CoordinateSpace,
+			             Function = Forward<SampleFunctionType>(SampleFunction)]()
+		             {
+			             LLM_SCOPE_BYTAG(TrickyUtilities);
+			             FTrickySplineSampler Sampler(SplineCurves, DefaultUpVector, ComponentTransform);
+			             TArray<FTransform> Transforms;
+			             Function(Sampler, CoordinateSpace, Transforms);
+			             return Transforms;
+		             });
+	}
+
+	/** Waits for an async spline sampling and writes its result into a Blueprint output. */
+	class FSplineSamplingLatentAction : public FPendingLatentAction
+	{
+	public:
+		FSplineSamplingLatentAction(TFuture<TArray<FTransform>>&& InFuture,
+		                            TArray<FTransform>& InOutTransforms,
+		                            const FLatentActionInfo& LatentInfo)
+			: Future(MoveTemp(InFuture)),
+			  OutTransforms(InOutTransforms),
+			  ExecutionFunction(LatentInfo.ExecutionFunction),
+			  OutputLink(LatentInfo.Linkage),
+			  CallbackTarget(LatentInfo.CallbackTarget)
+		{
+		}
+
+		virtual void UpdateOperation(FLatentResponse& Response) override
+		{
+			if (!Future.IsReady())
+			{
+				return;
+			}
+
+			OutTransforms = Future.Consume();
+			Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
+		}
+
+	private:
+		TFuture<TArray<FTransform>> Future;
+
+		TArray<FTransform>& OutTransforms;
+
+		FName ExecutionFunction;
+
+		int32 OutputLink;
+
+		FWeakObjectPtr CallbackTarget;
+	};
+
+	void AddSplineSamplingLatentAction(UObject* WorldContextObject,
+	                                   TFuture<TArray<FTransform>>&& Future,
+	                                   TArray<FTransform>& OutTransforms,
+	                                   const FLatentActionInfo& LatentInfo)
+	{
+		UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+
+		if (!IsValid(World))
+		{
+			return;
+		}
+
+		FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
+
+		if (LatentActionManager.FindExistingAction<FSplineSamplingLatentAction>(LatentInfo.CallbackTarget,
+		                                                                         LatentInfo.UUID))
+		{
+			return;
+		}
+
+		LatentActionManager.AddNewAction(LatentInfo.CallbackTarget,
+		                                 LatentInfo.UUID,
+		                                 new FSplineSamplingLatentAction(MoveTemp(Future), OutTransforms, LatentInfo));
+	}
+}
+
+bool FTrickyPatternSettings::operator==(const FTrickyPatternSettings& Other) const
+{
+	return PatternType == Other.PatternType
+		&& GridSize == Other.GridSize
+		&& CellSize == Other.CellSize
+		&& PointsAmount == Other.PointsAmount
+		&& RingsAmount == Other.RingsAmount
+		&& MinPoints == Other.MinPoints
+		&& MaxPoints == Other.MaxPoints
+		&& Radius == Other.Radius
+		&& MinRadius == Other.MinRadius
+		&& MaxRadius == Other.MaxRadius
+		&& Height == Other.Height
+		&& RingDeltaAngle == Other.RingDeltaAngle
+		&& AngleDeg == Other.AngleDeg
+		&& Latitude == Other.Latitude
+		&& Longitude == Other.Longitude
+		&& Direction == Other.Direction;
+}
 
 void UTrickyUtilityLibrary::CalculateTimelinePlayRate(UTimelineComponent* Timeline, const float DesiredTime)
 {
+	TRICKY_UTILITIES_SCOPE(CalculateTimelinePlayRate);
+
 	if (!IsValid(Timeline) || DesiredTime <= 0.f)
 	{
 		return;
@@ -29,6 +1350,9 @@ void UTrickyUtilityLibrary::FormatTimeSeconds(const float TimeSeconds,
                                               const EStringTimeFormat TimeFormat,
                                               FString& OutResult)
 {
+	TRICKY_UTILITIES_SCOPE(FormatTimeSeconds);
+	LLM_SCOPE_BYTAG(TrickyUtilities);
+
 	const FTimespan Timespan = UKismetMathLibrary::FromSeconds(TimeSeconds);
 	const int32 TotalMinutes = static_cast<int32>(Timespan.GetTotalMinutes());
 	const int32 Seconds = Timespan.GetSeconds();
@@ -80,27 +1404,26 @@ void UTrickyUtilityLibrary::CalculateGridTransforms(const FTransform& Origin,
                                                     const FVector2D& CellSize,
                                                     TArray<FTransform>& OutTransforms)
 {
-	if (SizeX <= 0 || SizeY <= 0 || CellSize.X <= 0.f || CellSize.Y <= 0.f)
-	{
-		return;
-	}
-	
-	const FVector OriginFwdVec = Origin.GetRotation().GetForwardVector();
-	const FVector OriginRightVec = Origin.GetRotation().GetRightVector();
+	TRICKY_UTILITIES_SCOPE(CalculateGridTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
 
-	FTransform NewTransform = FTransform::Identity;
+	FTransformArrayWriter Writer(OutTransforms);
+	GenerateGrid(Origin, SizeX, SizeY, CellSize, Writer);
+}
 
-	for (int32 x = 0; x < SizeX; ++x)
-	{
-		for (int32 y = 0; y < SizeY; ++y)
-		{
-			FVector NewLocation = FVector::ZeroVector;
-			NewLocation += x * CellSize.X * OriginFwdVec;
-			NewLocation += y * CellSize.Y * OriginRightVec;
-			NewTransform.SetLocation(NewLocation);
-			OutTransforms.Emplace(Origin * NewTransform);
-		}
-	}
+void UTrickyUtilityLibrary::CalculateGridTransforms(const FTransform& Origin,
+                                                    const int32 SizeX,
+                                                    const int32 SizeY,
+                                                    const FVector2D& CellSize,
+                                                    FTrickyPatternBuffer& OutBuffer)
+{
+	TRICKY_UTILITIES_SCOPE(CalculateGridTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const FTrickyBufferStatScope OutputStatScope(OutBuffer);
+
+	FPatternBufferWriter Writer(OutBuffer);
+	GenerateGrid(Origin, SizeX, SizeY, CellSize, Writer);
 }
 
 void UTrickyUtilityLibrary::CalculateCubeTransforms(const FTransform& Origin,
@@ -110,32 +1433,27 @@ void UTrickyUtilityLibrary::CalculateCubeTransforms(const FTransform& Origin,
                                                     const FVector& CellSize,
                                                     TArray<FTransform>& OutTransforms)
 {
-	if (SizeX <= 0 || SizeY <= 0 || SizeZ <= 0 || CellSize.X <= 0.f || CellSize.Y <= 0.f || CellSize.Z <= 0.f)
-	{
-		return;
-	}
-	
-	const FVector OriginFwdVec = Origin.GetRotation().GetForwardVector();
-	const FVector OriginRightVec = Origin.GetRotation().GetRightVector();
-	const FVector OriginUpVec = Origin.GetRotation().GetUpVector();
+	TRICKY_UTILITIES_SCOPE(CalculateCubeTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
 
-	FTransform NewTransform = FTransform::Identity;
+	FTransformArrayWriter Writer(OutTransforms);
+	GenerateCube(Origin, SizeX, SizeY, SizeZ, CellSize, Writer);
+}
 
-	for (int32 x = 0; x < SizeX; ++x)
-	{
-		for (int32 y = 0; y < SizeY; ++y)
-		{
-			for (int32 z = 0; z < SizeZ; ++z)
-			{
-				FVector NewLocation = FVector::ZeroVector;
-				NewLocation += x * CellSize.X * OriginFwdVec;
-				NewLocation += y * CellSize.Y * OriginRightVec;
-				NewLocation += z * CellSize.Z * OriginUpVec;
-				NewTransform.SetLocation(NewLocation);
-				OutTransforms.Emplace(Origin * NewTransform);
-			}
-		}
-	}
+void UTrickyUtilityLibrary::CalculateCubeTransforms(const FTransform& Origin,
+                                                    const int32 SizeX,
+                                                    const int32 SizeY,
+                                                    const int32 SizeZ,
+                                                    const FVector& CellSize,
+                                                    FTrickyPatternBuffer& OutBuffer)
+{
+	TRICKY_UTILITIES_SCOPE(CalculateCubeTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const FTrickyBufferStatScope OutputStatScope(OutBuffer);
+
+	FPatternBufferWriter Writer(OutBuffer);
+	GenerateCube(Origin, SizeX, SizeY, SizeZ, CellSize, Writer);
 }
 
 void UTrickyUtilityLibrary::CalculateRingTransform(const FTransform& Origin,
@@ -144,29 +1462,32 @@ void UTrickyUtilityLibrary::CalculateRingTransform(const FTransform& Origin,
                                                    const EPointDirection Direction,
                                                    TArray<FTransform>& OutTransforms)
 {
-	if (PointsAmount <= 0 || Radius < 0.f)
-	{
-		return;
-	}
-
-	const float Theta = (2.f * PI) / PointsAmount;
-	FTransform NewTransform = FTransform::Identity;
+	TRICKY_UTILITIES_SCOPE(CalculateRingTransform);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
 
-	for (int32 i = 0; i < PointsAmount; ++i)
+	FTransformArrayWriter Writer(OutTransforms);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
 	{
-		const float Angle = Theta * i;
-		FVector NewLocation = FVector::ZeroVector;
-		NewLocation.X = Radius * FMath::Cos(Angle);
-		NewLocation.Y = Radius * FMath::Sin(Angle);
-		NewTransform.SetLocation(NewLocation);
-		NewTransform *= Origin;
+		GenerateRing<decltype(DirectionTag)::Value>(Origin, PointsAmount, Radius, Writer);
+	});
+}
 
-		FRotator PointRotation = FRotator::ZeroRotator;
-		CalculatePointRotation(Origin, NewTransform, Direction, PointRotation);
-		NewTransform.SetRotation(PointRotation.Quaternion());
+void UTrickyUtilityLibrary::CalculateRingTransform(const FTransform& Origin,
+                                                   const int32 PointsAmount,
+                                                   const float Radius,
+                                                   const EPointDirection Direction,
+                                                   FTrickyPatternBuffer& OutBuffer)
+{
+	TRICKY_UTILITIES_SCOPE(CalculateRingTransform);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const FTrickyBufferStatScope OutputStatScope(OutBuffer);
 
-		OutTransforms.Emplace(NewTransform);
-	}
+	FPatternBufferWriter Writer(OutBuffer);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
+	{
+		GenerateRing<decltype(DirectionTag)::Value>(Origin, PointsAmount, Radius, Writer);
+	});
 }
 
 void UTrickyUtilityLibrary::CalculateConcentricRingsTransforms(const FTransform& Origin,
@@ -178,29 +1499,47 @@ void UTrickyUtilityLibrary::CalculateConcentricRingsTransforms(const FTransform&
                                                                const EPointDirection Direction,
                                                                TArray<FTransform>& OutTransforms)
 {
-	if (RingsAmount <= 0 || PointsPerRing <= 0 || MinRadius < 0.f || MaxRadius <= MinRadius)
+	TRICKY_UTILITIES_SCOPE(CalculateConcentricRingsTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
+
+	FTransformArrayWriter Writer(OutTransforms);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
 	{
-		return;
-	}
+		GenerateConcentricRings<decltype(DirectionTag)::Value>(Origin,
+		                                                       RingsAmount,
+		                                                       PointsPerRing,
+		                                                       MinRadius,
+		                                                       MaxRadius,
+		                                                       RingDeltaAngle,
+		                                                       Writer);
+	});
+}
 
-	const float RadiusStep = (MaxRadius - MinRadius) / (RingsAmount - 1);
-	FTransform RingOrigin = Origin;
-	const FVector OriginFwdVector = RingOrigin.GetRotation().GetForwardVector();
-	const FVector OriginUpVector = RingOrigin.GetRotation().GetUpVector();
+void UTrickyUtilityLibrary::CalculateConcentricRingsTransforms(const FTransform& Origin,
+                                                               const int32 RingsAmount,
+                                                               const int32 PointsPerRing,
+                                                               const float MinRadius,
+                                                               const float MaxRadius,
+                                                               const float RingDeltaAngle,
+                                                               const EPointDirection Direction,
+                                                               FTrickyPatternBuffer& OutBuffer)
+{
+	TRICKY_UTILITIES_SCOPE(CalculateConcentricRingsTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const FTrickyBufferStatScope OutputStatScope(OutBuffer);
 
-	for (int32 i = 0; i < RingsAmount; ++i)
+	FPatternBufferWriter Writer(OutBuffer);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
 	{
-		const FVector XAxis = OriginFwdVector.RotateAngleAxis(RingDeltaAngle * i, OriginUpVector);
-		const FMatrix RotationMatrix = FRotationMatrix::MakeFromXZ(XAxis, OriginUpVector);
-		const FRotator PointRotation = RotationMatrix.Rotator();
-		RingOrigin.SetRotation(PointRotation.Quaternion());
-
-		const float RingRadius = MinRadius + RadiusStep * i;
-		
-		TArray<FTransform> RingTransforms;
-		CalculateRingTransform(RingOrigin, PointsPerRing, RingRadius, Direction, RingTransforms);
-		OutTransforms.Append(RingTransforms);
-	}
+		GenerateConcentricRings<decltype(DirectionTag)::Value>(Origin,
+		                                                       RingsAmount,
+		                                                       PointsPerRing,
+		                                                       MinRadius,
+		                                                       MaxRadius,
+		                                                       RingDeltaAngle,
+		                                                       Writer);
+	});
 }
 
 void UTrickyUtilityLibrary::CalculateDynamicConcentricRingsTransforms(const FTransform& Origin,
@@ -213,36 +1552,50 @@ void UTrickyUtilityLibrary::CalculateDynamicConcentricRingsTransforms(const FTra
                                                                       const EPointDirection Direction,
                                                                       TArray<FTransform>& OutTransforms)
 {
-	if (RingsAmount <= 0 || MinPoints <= 0 || MaxPoints <= MinPoints || MinRadius < 0.f || MaxRadius <= MinRadius)
-	{
-		return;
-	}
-
-	const float RadiusStep = (MaxRadius - MinRadius) / (RingsAmount - 1);
-	FTransform RingOrigin = Origin;
-	const FVector OriginFwdVector = RingOrigin.GetRotation().GetForwardVector();
-	const FVector OriginUpVector = RingOrigin.GetRotation().GetUpVector();
+	TRICKY_UTILITIES_SCOPE(CalculateDynamicConcentricRingsTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
 
-	for (int32 i = 0; i < RingsAmount; ++i)
+	FTransformArrayWriter Writer(OutTransforms);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
 	{
-		const FVector XAxis = OriginFwdVector.RotateAngleAxis(RingDeltaAngle * i, OriginUpVector);
-		const FMatrix RotationMatrix = FRotationMatrix::MakeFromXZ(XAxis, OriginUpVector);
-		const FRotator PointRotation = RotationMatrix.Rotator();
-		RingOrigin.SetRotation(PointRotation.Quaternion());
-
-		TArray<FTransform> RingTransforms;
-		const float RingRadius = MinRadius + RadiusStep * i;
+		GenerateDynamicConcentricRings<decltype(DirectionTag)::Value>(Origin,
+		                                                              RingsAmount,
+		                                                              MinPoints,
+		                                                              MaxPoints,
+		                                                              MinRadius,
+		                                                              MaxRadius,
+		                                                              RingDeltaAngle,
+		                                                              Writer);
+	});
+}
 
-		int32 PointsAmount = MinPoints;
-		if (i > 0 && MinRadius > 0.f)
-		{
-			const float CircumferenceRatio = RingRadius / MinRadius;
-			PointsAmount = FMath::Clamp(FMath::RoundToInt(MinPoints * CircumferenceRatio), MinPoints, MaxPoints);
-		}
+void UTrickyUtilityLibrary::CalculateDynamicConcentricRingsTransforms(const FTransform& Origin,
+                                                                      const int32 RingsAmount,
+                                                                      const int32 MinPoints,
+                                                                      const int32 MaxPoints,
+                                                                      const float MinRadius,
+                                                                      const float MaxRadius,
+                                                                      const float RingDeltaAngle,
+                                                                      const EPointDirection Direction,
+                                                                      FTrickyPatternBuffer& OutBuffer)
+{
+	TRICKY_UTILITIES_SCOPE(CalculateDynamicConcentricRingsTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const FTrickyBufferStatScope OutputStatScope(OutBuffer);
 
-		CalculateRingTransform(RingOrigin, PointsAmount, RingRadius, Direction, RingTransforms);
-		OutTransforms.Append(RingTransforms);
-	}
+	FPatternBufferWriter Writer(OutBuffer);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
+	{
+		GenerateDynamicConcentricRings<decltype(DirectionTag)::Value>(Origin,
+		                                                              RingsAmount,
+		                                                              MinPoints,
+		                                                              MaxPoints,
+		                                                              MinRadius,
+		                                                              MaxRadius,
+		                                                              RingDeltaAngle,
+		                                                              Writer);
+	});
 }
 
 void UTrickyUtilityLibrary::CalculateCylinderTransforms(const FTransform& Origin,
@@ -254,29 +1607,47 @@ void UTrickyUtilityLibrary::CalculateCylinderTransforms(const FTransform& Origin
                                                         const EPointDirection Direction,
                                                         TArray<FTransform>& OutTransforms)
 {
-	if (RingsAmount <= 0 || PointsPerRing <= 0 || Radius < 0.f || Height < 0.f)
+	TRICKY_UTILITIES_SCOPE(CalculateCylinderTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
+
+	FTransformArrayWriter Writer(OutTransforms);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
 	{
-		return;
-	}
+		GenerateCylinder<decltype(DirectionTag)::Value>(Origin,
+		                                                RingsAmount,
+		                                                PointsPerRing,
+		                                                Radius,
+		                                                Height,
+		                                                RingDeltaAngle,
+		                                                Writer);
+	});
+}
 
-	FTransform RingOrigin = Origin;
-	const FVector OriginLocation = RingOrigin.GetLocation();
-	const FVector OriginFwdVector = RingOrigin.GetRotation().GetForwardVector();
-	const FVector OriginUpVector = RingOrigin.GetRotation().GetUpVector();
-	const float RingDisplacement = Height / (RingsAmount - 1);
+void UTrickyUtilityLibrary::CalculateCylinderTransforms(const FTransform& Origin,
+                                                        const int32 RingsAmount,
+                                                        const int32 PointsPerRing,
+                                                        const float Radius,
+                                                        const float Height,
+                                                        const float RingDeltaAngle,
+                                                        const EPointDirection Direction,
+                                                        FTrickyPatternBuffer& OutBuffer)
+{
+	TRICKY_UTILITIES_SCOPE(CalculateCylinderTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const FTrickyBufferStatScope OutputStatScope(OutBuffer);
 
-	for (int32 i = 0; i < RingsAmount; ++i)
+	FPatternBufferWriter Writer(OutBuffer);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
 	{
-		RingOrigin.SetLocation(OriginLocation + OriginUpVector * RingDisplacement * i);
-		const FVector XAxis = OriginFwdVector.RotateAngleAxis(RingDeltaAngle * i, OriginUpVector);
-		const FMatrix RotationMatrix = FRotationMatrix::MakeFromXZ(XAxis, OriginUpVector);
-		const FRotator PointRotation = RotationMatrix.Rotator();
-		RingOrigin.SetRotation(PointRotation.Quaternion());
-		
-		TArray<FTransform> RingTransforms;
-		CalculateRingTransform(RingOrigin, PointsPerRing, Radius, Direction, RingTransforms);
-		OutTransforms.Append(RingTransforms);
-	}
+		GenerateCylinder<decltype(DirectionTag)::Value>(Origin,
+		                                                RingsAmount,
+		                                                PointsPerRing,
+		                                                Radius,
+		                                                Height,
+		                                                RingDeltaAngle,
+		                                                Writer);
+	});
 }
 
 void UTrickyUtilityLibrary::CalculateArcTransforms(const FTransform& Origin,
@@ -286,40 +1657,33 @@ void UTrickyUtilityLibrary::CalculateArcTransforms(const FTransform& Origin,
                                                    const EPointDirection Direction,
                                                    TArray<FTransform>& OutTransforms)
 {
-	if (PointsAmount <= 0 || Radius < 0.f || AngleDeg < 0.f)
-	{
-		return;
-	}
-
-	const float AngleRad = UKismetMathLibrary::DegreesToRadians(AngleDeg);
-	const float Theta = AngleRad / (PointsAmount - 1);
+	TRICKY_UTILITIES_SCOPE(CalculateArcTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
 
-	FTransform ArcOrigin = Origin;
-	const FVector OriginFwdVector = ArcOrigin.GetRotation().GetForwardVector();
-	const FVector OriginUpVector = Origin.GetRotation().GetUpVector();
-
-	const FVector XAxis = OriginFwdVector.RotateAngleAxis(-AngleDeg * 0.5f, OriginUpVector);
-	const FMatrix ArcRotationMatrix = FRotationMatrix::MakeFromXZ(XAxis, OriginUpVector);
-	const FRotator ArcRotation = ArcRotationMatrix.Rotator();
-	ArcOrigin.SetRotation(ArcRotation.Quaternion());
+	FTransformArrayWriter Writer(OutTransforms);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
+	{
+		GenerateArc<decltype(DirectionTag)::Value>(Origin, PointsAmount, Radius, AngleDeg, Writer);
+	});
+}
 
-	FTransform NewTransform = FTransform::Identity;
+void UTrickyUtilityLibrary::CalculateArcTransforms(const FTransform& Origin,
+                                                   const int32 PointsAmount,
+                                                   const float Radius,
+                                                   const float AngleDeg,
+                                                   const EPointDirection Direction,
+                                                   FTrickyPatternBuffer& OutBuffer)
+{
+	TRICKY_UTILITIES_SCOPE(CalculateArcTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const FTrickyBufferStatScope OutputStatScope(OutBuffer);
 
-	for (int32 i = 0; i < PointsAmount; ++i)
+	FPatternBufferWriter Writer(OutBuffer);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
 	{
-		const float Angle = Theta * i;
-		FVector NewLocation = FVector::ZeroVector;
-		NewLocation.X = Radius * FMath::Cos(Angle);
-		NewLocation.Y = Radius * FMath::Sin(Angle);
-		NewTransform.SetLocation(NewLocation);
-		NewTransform *= ArcOrigin;
-
-		FRotator PointRotation = FRotator::ZeroRotator;
-		CalculatePointRotation(ArcOrigin, NewTransform, Direction, PointRotation);
-		NewTransform.SetRotation(PointRotation.Quaternion());
-
-		OutTransforms.Emplace(NewTransform);
-	}
+		GenerateArc<decltype(DirectionTag)::Value>(Origin, PointsAmount, Radius, AngleDeg, Writer);
+	});
 }
 
 void UTrickyUtilityLibrary::CalculateConcentricArcsTransforms(const FTransform& Origin,
@@ -331,20 +1695,47 @@ void UTrickyUtilityLibrary::CalculateConcentricArcsTransforms(const FTransform&
                                                               const EPointDirection Direction,
                                                               TArray<FTransform>& OutTransforms)
 {
-	if (ArcsAmount <= 0 || PointsPerArc <= 0 || MinRadius < 0.f || MaxRadius <= MinRadius)
+	TRICKY_UTILITIES_SCOPE(CalculateConcentricArcsTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
+
+	FTransformArrayWriter Writer(OutTransforms);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
 	{
-		return;
-	}
+		GenerateConcentricArcs<decltype(DirectionTag)::Value>(Origin,
+		                                                      ArcsAmount,
+		                                                      PointsPerArc,
+		                                                      MinRadius,
+		                                                      MaxRadius,
+		                                                      AngleDeg,
+		                                                      Writer);
+	});
+}
+
+void UTrickyUtilityLibrary::CalculateConcentricArcsTransforms(const FTransform& Origin,
+                                                              const int32 ArcsAmount,
+                                                              const int32 PointsPerArc,
+                                                              const float MinRadius,
+                                                              const float MaxRadius,
+                                                              const float AngleDeg,
+                                                              const EPointDirection Direction,
+                                                              FTrickyPatternBuffer& OutBuffer)
+{
+	TRICKY_UTILITIES_SCOPE(CalculateConcentricArcsTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const FTrickyBufferStatScope OutputStatScope(OutBuffer);
 
-	const float RadiusStep = (MaxRadius - MinRadius) / (ArcsAmount - 1);
-	for (int32 i = 0; i < ArcsAmount; ++i)
+	FPatternBufferWriter Writer(OutBuffer);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
 	{
-		const float ArcRadius = MinRadius + RadiusStep * i;
-		
-		TArray<FTransform> RingTransforms;
-		CalculateArcTransforms(Origin, PointsPerArc, ArcRadius, AngleDeg, Direction, RingTransforms);
-		OutTransforms.Append(RingTransforms);
-	}
+		GenerateConcentricArcs<decltype(DirectionTag)::Value>(Origin,
+		                                                      ArcsAmount,
+		                                                      PointsPerArc,
+		                                                      MinRadius,
+		                                                      MaxRadius,
+		                                                      AngleDeg,
+		                                                      Writer);
+	});
 }
 
 void UTrickyUtilityLibrary::CalculateDynamicConcentricArcsTransforms(const FTransform& Origin,
@@ -357,29 +1748,50 @@ void UTrickyUtilityLibrary::CalculateDynamicConcentricArcsTransforms(const FTran
                                                                      const EPointDirection Direction,
                                                                      TArray<FTransform>& OutTransforms)
 {
-	if (ArcsAmount <= 0 || MinPoints <= 0 || MaxPoints <= MinPoints || MinRadius < 0.f || MaxRadius <= MinRadius)
-	{
-		return;
-	}
+	TRICKY_UTILITIES_SCOPE(CalculateDynamicConcentricArcsTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
 
-	const float RadiusStep = (MaxRadius - MinRadius) / (ArcsAmount - 1);
-	
-	for (int32 i = 0; i < ArcsAmount; ++i)
+	FTransformArrayWriter Writer(OutTransforms);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
 	{
-		const float ArcRadius = MinRadius + RadiusStep * i;
-
-		int32 PointsAmount = MinPoints;
+		GenerateDynamicConcentricArcs<decltype(DirectionTag)::Value>(Origin,
+		                                                             ArcsAmount,
+		                                                             MinPoints,
+		                                                             MaxPoints,
+		                                                             MinRadius,
+		                                                             MaxRadius,
+		                                                             AngleDeg,
+		                                                             Writer);
+	});
+}
 
-		if (i > 0 && MinRadius > 0.f)
-		{
-			const float CircumferenceRatio = ArcRadius / MinRadius;
-			PointsAmount = FMath::Clamp(FMath::RoundToInt(MinPoints * CircumferenceRatio), MinPoints, MaxPoints);
-		}
+void UTrickyUtilityLibrary::CalculateDynamicConcentricArcsTransforms(const FTransform& Origin,
+                                                                     const int32 ArcsAmount,
+                                                                     const int32 MinPoints,
+                                                                     const int32 MaxPoints,
+                                                                     const float MinRadius,
+                                                                     const float MaxRadius,
+                                                                     const float AngleDeg,
+                                                                     const EPointDirection Direction,
+                                                                     FTrickyPatternBuffer& OutBuffer)
+{
+	TRICKY_UTILITIES_SCOPE(CalculateDynamicConcentricArcsTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const FTrickyBufferStatScope OutputStatScope(OutBuffer);
 
-		TArray<FTransform> RingTransforms;
-		CalculateArcTransforms(Origin, PointsAmount, ArcRadius, AngleDeg, Direction, RingTransforms);
-		OutTransforms.Append(RingTransforms);
-	}
+	FPatternBufferWriter Writer(OutBuffer);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
+	{
+		GenerateDynamicConcentricArcs<decltype(DirectionTag)::Value>(Origin,
+		                                                             ArcsAmount,
+		                                                             MinPoints,
+		                                                             MaxPoints,
+		                                                             MinRadius,
+		                                                             MaxRadius,
+		                                                             AngleDeg,
+		                                                             Writer);
+	});
 }
 
 void UTrickyUtilityLibrary::CalculateArcCylinderTransforms(const FTransform& Origin,
@@ -391,24 +1803,47 @@ void UTrickyUtilityLibrary::CalculateArcCylinderTransforms(const FTransform& Ori
                                                            const EPointDirection Direction,
                                                            TArray<FTransform>& OutTransforms)
 {
-	if (ArcsAmount <= 0 || PointsPerArc <= 0 || Radius < 0.f || Height < 0.f)
+	TRICKY_UTILITIES_SCOPE(CalculateArcCylinderTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
+
+	FTransformArrayWriter Writer(OutTransforms);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
 	{
-		return;
-	}
+		GenerateArcCylinder<decltype(DirectionTag)::Value>(Origin,
+		                                                   ArcsAmount,
+		                                                   PointsPerArc,
+		                                                   Radius,
+		                                                   Height,
+		                                                   AngleDeg,
+		                                                   Writer);
+	});
+}
 
-	FTransform ArcOrigin = Origin;
-	const FVector OriginLocation = ArcOrigin.GetLocation();
-	const FVector OriginUpVector = ArcOrigin.GetRotation().GetUpVector();
-	const float ArcDisplacement = Height / (ArcsAmount - 1);
+void UTrickyUtilityLibrary::CalculateArcCylinderTransforms(const FTransform& Origin,
+                                                           const int32 ArcsAmount,
+                                                           const int32 PointsPerArc,
+                                                           const float Radius,
+                                                           const float Height,
+                                                           const float AngleDeg,
+                                                           const EPointDirection Direction,
+                                                           FTrickyPatternBuffer& OutBuffer)
+{
+	TRICKY_UTILITIES_SCOPE(CalculateArcCylinderTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const FTrickyBufferStatScope OutputStatScope(OutBuffer);
 
-	for (int32 i = 0; i < ArcsAmount; ++i)
+	FPatternBufferWriter Writer(OutBuffer);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
 	{
-		ArcOrigin.SetLocation(OriginLocation + OriginUpVector * ArcDisplacement * i);
-		
-		TArray<FTransform> ArcsTransforms;
-		CalculateArcTransforms(ArcOrigin, PointsPerArc, Radius, AngleDeg, Direction, ArcsTransforms);
-		OutTransforms.Append(ArcsTransforms);
-	}
+		GenerateArcCylinder<decltype(DirectionTag)::Value>(Origin,
+		                                                   ArcsAmount,
+		                                                   PointsPerArc,
+		                                                   Radius,
+		                                                   Height,
+		                                                   AngleDeg,
+		                                                   Writer);
+	});
 }
 
 void UTrickyUtilityLibrary::CalculateSphereTransforms(const FTransform& Origin,
@@ -421,82 +1856,209 @@ void UTrickyUtilityLibrary::CalculateSphereTransforms(const FTransform& Origin,
                                                       const EPointDirection Direction,
                                                       TArray<FTransform>& OutTransforms)
 {
-	if (PointsAmount <= 0 || Radius < 0.f)
+	TRICKY_UTILITIES_SCOPE(CalculateSphereTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
+
+	FTransformArrayWriter Writer(OutTransforms);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
 	{
-		return;
-	}
+		GenerateSphere<decltype(DirectionTag)::Value>(Origin,
+		                                              Radius,
+		                                              PointsAmount,
+		                                              MinLatitude,
+		                                              MaxLatitude,
+		                                              MinLongitude,
+		                                              MaxLongitude,
+		                                              Writer);
+	});
+}
+
+void UTrickyUtilityLibrary::CalculateSphereTransforms(const FTransform& Origin,
+                                                      const float Radius,
+                                                      const int32 PointsAmount,
+                                                      const float MinLatitude,
+                                                      const float MaxLatitude,
+                                                      const float MinLongitude,
+                                                      const float MaxLongitude,
+                                                      const EPointDirection Direction,
+                                                      FTrickyPatternBuffer& OutBuffer)
+{
+	TRICKY_UTILITIES_SCOPE(CalculateSphereTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const FTrickyBufferStatScope OutputStatScope(OutBuffer);
 
-	const float Phi = PI * (3.f - FMath::Sqrt(5.f));
-	constexpr float Tau = PI * 2;
+	FPatternBufferWriter Writer(OutBuffer);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
+	{
+		GenerateSphere<decltype(DirectionTag)::Value>(Origin,
+		                                              Radius,
+		                                              PointsAmount,
+		                                              MinLatitude,
+		                                              MaxLatitude,
+		                                              MinLongitude,
+		                                              MaxLongitude,
+		                                              Writer);
+	});
+}
 
-	const float MinLongitudeAngle = MinLongitude * 360.f;
-	const float MaxLongitudeAngle = MaxLongitude * 360.f;
-	const float MinLongitudeRad = FMath::DegreesToRadians(MinLongitudeAngle);
-	const float MaxLongitudeRad = FMath::DegreesToRadians(MaxLongitudeAngle);
+void UTrickyUtilityLibrary::CalculateSunFlowerTransforms(const FTransform& Origin,
+                                                         const float Radius,
+                                                         const int32 PointsAmount,
+                                                         const EPointDirection Direction,
+                                                         TArray<FTransform>& OutTransforms)
+{
+	TRICKY_UTILITIES_SCOPE(CalculateSunFlowerTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
 
-	FTransform NewTransform = FTransform::Identity;
+	FTransformArrayWriter Writer(OutTransforms);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
+	{
+		GenerateSunFlower<decltype(DirectionTag)::Value>(Origin, Radius, PointsAmount, Writer);
+	});
+}
 
-	for (int32 i = 0; i < PointsAmount; ++i)
+void UTrickyUtilityLibrary::CalculateSunFlowerTransforms(const FTransform& Origin,
+                                                         const float Radius,
+                                                         const int32 PointsAmount,
+                                                         const EPointDirection Direction,
+                                                         FTrickyPatternBuffer& OutBuffer)
+{
+	TRICKY_UTILITIES_SCOPE(CalculateSunFlowerTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const FTrickyBufferStatScope OutputStatScope(OutBuffer);
+
+	FPatternBufferWriter Writer(OutBuffer);
+	DispatchPointDirection(Direction, [&](auto DirectionTag)
 	{
-		const float Z = ((i / (static_cast<float>(PointsAmount) - 1.f)) * (MaxLatitude - MinLatitude) + MinLatitude) *
-			2.f - 1.f;
-		const float RadiusZ = FMath::Sqrt(1.f - Z * Z);
-		float Theta = Phi * static_cast<float>(i);
+		GenerateSunFlower<decltype(DirectionTag)::Value>(Origin, Radius, PointsAmount, Writer);
+	});
+}
 
-		if (MinLongitudeAngle != 0.f || MaxLongitudeAngle != 360.f)
-		{
-			Theta = FMath::Fmod(Theta, Tau);
-			Theta = Theta < 0 ? Theta + Tau : Theta;
-			Theta = Theta * MaxLongitudeRad / Tau + MinLongitudeRad;
-		}
+void UTrickyUtilityLibrary::CalculatePatternTransforms(const FTransform& Origin,
+                                                       const FTrickyPatternSettings& Settings,
+                                                       TArray<FTransform>& OutTransforms)
+{
+	TRICKY_UTILITIES_SCOPE(CalculatePatternTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+
+	CalculatePattern(Origin, Settings, OutTransforms);
+}
 
-		const float X = FMath::Sin(Theta) * RadiusZ;
-		const float Y = FMath::Cos(Theta) * RadiusZ;
+void UTrickyUtilityLibrary::CalculatePatternTransforms(const FTransform& Origin,
+                                                       const FTrickyPatternSettings& Settings,
+                                                       FTrickyPatternBuffer& OutBuffer)
+{
+	TRICKY_UTILITIES_SCOPE(CalculatePatternTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
 
-		FVector Location{X, Y, Z};
-		Location *= Radius;
-		Location = Origin.TransformPosition(Location);
-		NewTransform.SetLocation(Location);
+	CalculatePattern(Origin, Settings, OutBuffer);
+}
 
-		FRotator PointRotation = FRotator::ZeroRotator;
-		CalculatePointRotation(Origin, NewTransform, Direction, PointRotation);
-		NewTransform.SetRotation(PointRotation.Quaternion());
+void UTrickyUtilityLibrary::CalculateCachedPatternTransforms(const FTransform& Origin,
+                                                             const FTrickyPatternSettings& Settings,
+                                                             TArray<FTransform>& OutTransforms)
+{
+	TRICKY_UTILITIES_SCOPE(CalculateCachedPatternTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
 
-		OutTransforms.Emplace(NewTransform);
-	}
+	FTrickyPatternCache::Get().CalculatePatternTransforms(Origin, Settings, OutTransforms);
 }
 
-void UTrickyUtilityLibrary::CalculateSunFlowerTransforms(const FTransform& Origin,
-                                                         const float Radius,
-                                                         const int32 PointsAmount,
-                                                         const EPointDirection Direction,
-                                                         TArray<FTransform>& OutTransforms)
+void UTrickyUtilityLibrary::CalculatePatternTransformsForOrigins(const TArray<FTransform>& Origins,
+                                                                 const FTrickyPatternSettings& Settings,
+                                                                 TArray<FTransform>& OutTransforms,
+                                                                 TArray<int32>& OutOffsets)
 {
-	if (PointsAmount <= 0 || Radius < 0.f)
+	TRICKY_UTILITIES_SCOPE(CalculatePatternTransformsForOrigins);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
+
+	if (Origins.IsEmpty())
 	{
 		return;
 	}
 
-	const float GoldenAngle = PI * (3.0f - FMath::Sqrt(5.0f));
-	FTransform NewTransform = FTransform::Identity;
+	const TSharedRef<const TArray<FTransform>> LocalTransforms = FTrickyPatternCache::Get().GetLocalPattern(Settings);
+	const int32 PatternSize = LocalTransforms->Num();
+	const int32 StartIndex = OutTransforms.AddUninitialized(PatternSize * Origins.Num());
 
-	for (int32 i = 0; i < PointsAmount; ++i)
+	OutOffsets.Reserve(OutOffsets.Num() + Origins.Num());
+
+	for (int32 i = 0; i < Origins.Num(); ++i)
 	{
-		const float PointRadius = Radius * FMath::Sqrt(static_cast<float>(i) / static_cast<float>(PointsAmount));
-		const float Angle = i * GoldenAngle;
+		OutOffsets.Emplace(StartIndex + i * PatternSize);
+	}
+
+	StampPatternAtOrigins(*LocalTransforms, Origins, OutTransforms.GetData() + StartIndex);
+}
 
-		FVector NewLocation = FVector::ZeroVector;
-		NewLocation.X = PointRadius * FMath::Cos(Angle);
-		NewLocation.Y = PointRadius * FMath::Sin(Angle);
-		NewTransform.SetLocation(NewLocation);
-		NewTransform *= Origin;
+void UTrickyUtilityLibrary::RebasePatternTransforms(const TArray<FTransform>& LocalTransforms,
+                                                    const FTransform& Origin,
+                                                    TArray<FTransform>& OutTransforms)
+{
+	TRICKY_UTILITIES_SCOPE(RebasePatternTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
 
-		FRotator PointRotation = FRotator::ZeroRotator;
-		CalculatePointRotation(Origin, NewTransform, Direction, PointRotation);
-		NewTransform.SetRotation(PointRotation.Quaternion());
+	const int32 StartIndex = OutTransforms.AddUninitialized(LocalTransforms.Num());
+	const FTransform* Source = LocalTransforms.GetData();
+	FTransform* Destination = OutTransforms.GetData() + StartIndex;
 
-		OutTransforms.Emplace(NewTransform);
-	}
+	ForEachPointRange(LocalTransforms.Num(), [&](const int32 RangeStart, const int32 RangeEnd)
+	{
+		for (int32 i = RangeStart; i < RangeEnd; ++i)
+		{
+			FTransform::Multiply(Destination + i, Source + i, &Origin);
+		}
+	});
+}
+
+void UTrickyUtilityLibrary::RebasePatternTransforms(TArray<FTransform>& InOutTransforms, const FTransform& Origin)
+{
+	TRICKY_UTILITIES_SCOPE(RebasePatternTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+
+	FTransform* Transforms = InOutTransforms.GetData();
+
+	ForEachPointRange(InOutTransforms.Num(), [&](const int32 RangeStart, const int32 RangeEnd)
+	{
+		for (int32 i = RangeStart; i < RangeEnd; ++i)
+		{
+			FTransform::Multiply(Transforms + i, Transforms + i, &Origin);
+		}
+	});
+}
+
+void UTrickyUtilityLibrary::RebasePatternTransforms(FTrickyPatternBuffer& InOutBuffer, const FTransform& Origin)
+{
+	TRICKY_UTILITIES_SCOPE(RebasePatternTransforms);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+
+	const FMatrix OriginMatrix = Origin.ToMatrixWithScale();
+	const FQuat OriginRotation = Origin.GetRotation();
+	const FVector OriginScale = Origin.GetScale3D();
+	FVector* Locations = InOutBuffer.Locations.GetData();
+	FQuat* Rotations = InOutBuffer.Rotations.GetData();
+	FVector* Scales = InOutBuffer.bStoreScales ? InOutBuffer.Scales.GetData() : nullptr;
+
+	ForEachPointRange(InOutBuffer.Num(), [&](const int32 RangeStart, const int32 RangeEnd)
+	{
+		for (int32 i = RangeStart; i < RangeEnd; ++i)
+		{
+			Locations[i] = OriginMatrix.TransformPosition(Locations[i]);
+			Rotations[i] = OriginRotation * Rotations[i];
+		}
+
+		if (Scales != nullptr)
+		{
+			for (int32 i = RangeStart; i < RangeEnd; ++i)
+			{
+				Scales[i] *= OriginScale;
+			}
+		}
+	});
 }
 
 void UTrickyUtilityLibrary::GetTransformsAlongSplineByPoints(USplineComponent* SplineComponent,
@@ -504,23 +2066,20 @@ void UTrickyUtilityLibrary::GetTransformsAlongSplineByPoints(USplineComponent* S
                                                              const bool bUseLocalSpace,
                                                              TArray<FTransform>& OutTransforms)
 {
+	TRICKY_UTILITIES_SCOPE(GetTransformsAlongSplineByPoints);
+	LLM_SCOPE_BYTAG(TrickyUtilities);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
+
 	if (!IsValid(SplineComponent) || PointsAmount <= 0)
 	{
 		return;
 	}
 
-	const float SplineLength = SplineComponent->GetSplineLength();
-	const float Displacement = SplineLength / (PointsAmount - 1);
-
-	for (int32 i = 0; i < PointsAmount; ++i)
-	{
-		const float Distance = Displacement * i;
-		const ESplineCoordinateSpace::Type CoordinateSpace = bUseLocalSpace
-			                                                     ? ESplineCoordinateSpace::Local
-			                                                     : ESplineCoordinateSpace::World;
-		const FTransform Transform = SplineComponent->GetTransformAtDistanceAlongSpline(Distance, CoordinateSpace);
-		OutTransforms.Emplace(Transform);
-	}
+	FTrickySplineSampler Sampler(*SplineComponent);
+	const ESplineCoordinateSpace::Type CoordinateSpace = bUseLocalSpace
+		                                                     ? ESplineCoordinateSpace::Local
+		                                                     : ESplineCoordinateSpace::World;
+	SampleTransformsByPoints(Sampler, CoordinateSpace, AddTransforms(OutTransforms, PointsAmount));
 }
 
 void UTrickyUtilityLibrary::GetLocationsAlongSplineByPoints(USplineComponent* SplineComponent,
@@ -528,22 +2087,26 @@ void UTrickyUtilityLibrary::GetLocationsAlongSplineByPoints(USplineComponent* Sp
                                                             const bool bUseLocalSpace,
                                                             TArray<FVector>& OutLocations)
 {
+	TRICKY_UTILITIES_SCOPE(GetLocationsAlongSplineByPoints);
+	LLM_SCOPE_BYTAG(TrickyUtilities);
+	const TTrickyOutputStatScope OutputStatScope(OutLocations);
+
 	if (!IsValid(SplineComponent) || PointsAmount <= 0)
 	{
 		return;
 	}
 
-	const float SplineLength = SplineComponent->GetSplineLength();
-	const float Displacement = SplineLength / (PointsAmount - 1);
+	FTrickySplineSampler Sampler(*SplineComponent);
+	const float Displacement = PointsAmount > 1 ? Sampler.GetSplineLength() / (PointsAmount - 1) : 0.f;
 	const ESplineCoordinateSpace::Type CoordinateSpace = bUseLocalSpace
 		                                                     ? ESplineCoordinateSpace::Local
 		                                                     : ESplineCoordinateSpace::World;
+	OutLocations.Reserve(OutLocations.Num() + PointsAmount);
 
 	for (int32 i = 0; i < PointsAmount; ++i)
 	{
 		const float Distance = Displacement * i;
-		const FVector Location = SplineComponent->GetLocationAtDistanceAlongSpline(Distance, CoordinateSpace);
-		OutLocations.Emplace(Location);
+		OutLocations.Emplace(Sampler.GetLocationAtDistance(Distance, CoordinateSpace));
 	}
 }
 
@@ -552,24 +2115,21 @@ void UTrickyUtilityLibrary::GetTransformsAlongSplineByDistance(USplineComponent*
                                                                const bool bUseLocalSpace,
                                                                TArray<FTransform>& OutTransforms)
 {
+	TRICKY_UTILITIES_SCOPE(GetTransformsAlongSplineByDistance);
+	LLM_SCOPE_BYTAG(TrickyUtilities);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
+
 	if (!IsValid(SplineComponent) || Distance <= 0.f)
 	{
 		return;
 	}
 
-	const float SplineLength = SplineComponent->GetSplineLength();
-	const float PointsAmount = SplineLength / Distance;
-	const float HalfDistance = Distance * 0.5f;
+	FTrickySplineSampler Sampler(*SplineComponent);
 	const ESplineCoordinateSpace::Type CoordinateSpace = bUseLocalSpace
 		                                                     ? ESplineCoordinateSpace::Local
 		                                                     : ESplineCoordinateSpace::World;
-
-	for (int32 i = 0; i < PointsAmount; ++i)
-	{
-		const float SplineDistance = (Distance * i) + HalfDistance;
-		const FTransform Transform = SplineComponent->GetTransformAtDistanceAlongSpline(SplineDistance, CoordinateSpace);
-		OutTransforms.Emplace(Transform);
-	}
+	const int32 PointsAmount = GetSplinePointsAmountByDistance(Sampler.GetSplineLength(), Distance);
+	SampleTransformsByDistance(Sampler, Distance, CoordinateSpace, AddTransforms(OutTransforms, PointsAmount));
 }
 
 void UTrickyUtilityLibrary::GetLocationsAlongSplineByDistance(USplineComponent* SplineComponent,
@@ -577,70 +2137,304 @@ void UTrickyUtilityLibrary::GetLocationsAlongSplineByDistance(USplineComponent*
                                                               const bool bUseLocalSpace,
                                                               TArray<FVector>& OutLocations)
 {
+	TRICKY_UTILITIES_SCOPE(GetLocationsAlongSplineByDistance);
+	LLM_SCOPE_BYTAG(TrickyUtilities);
+	const TTrickyOutputStatScope OutputStatScope(OutLocations);
+
 	if (!IsValid(SplineComponent) || Distance <= 0.f)
 	{
 		return;
 	}
 
-	const float SplineLength = SplineComponent->GetSplineLength();
-	const float PointsAmount = SplineLength / Distance;
+	FTrickySplineSampler Sampler(*SplineComponent);
+	const float PointsAmount = Sampler.GetSplineLength() / Distance;
 	const float HalfDistance = Distance * 0.5f;
 	const ESplineCoordinateSpace::Type CoordinateSpace = bUseLocalSpace
 		                                                     ? ESplineCoordinateSpace::Local
 		                                                     : ESplineCoordinateSpace::World;
+	OutLocations.Reserve(OutLocations.Num() + FMath::CeilToInt32(PointsAmount));
 
 	for (int32 i = 0; i < PointsAmount; ++i)
 	{
 		const float SplineDistance = (Distance * i) + HalfDistance;
-		const FVector Location = SplineComponent->GetLocationAtDistanceAlongSpline(SplineDistance, CoordinateSpace);
-		OutLocations.Emplace(Location);
+		OutLocations.Emplace(Sampler.GetLocationAtDistance(SplineDistance, CoordinateSpace));
 	}
 }
 
-void UTrickyUtilityLibrary::CalculatePointRotation(const FTransform& Origin,
-                                                   const FTransform& Point,
-                                                   const EPointDirection Direction,
-                                                   FRotator& OutRotation)
+void UTrickyUtilityLibrary::GetTransformsAlongSplineByCurvature(USplineComponent* SplineComponent,
+                                                                const float MinDistance,
+                                                                const float MaxDistance,
+                                                                const float MaxAngle,
+                                                                const bool bUseLocalSpace,
+                                                                TArray<FTransform>& OutTransforms)
 {
-	const FVector WorldLocation = Point.GetLocation();
-	const FVector WorldUpVector = Origin.GetRotation().GetUpVector();
-	const FVector OriginLocation = Origin.GetLocation();
+	TRICKY_UTILITIES_SCOPE(GetTransformsAlongSplineByCurvature);
+	LLM_SCOPE_BYTAG(TrickyUtilities);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
+
+	if (!IsValid(SplineComponent) || MinDistance <= 0.f || MaxDistance < MinDistance || MaxAngle <= 0.f)
+	{
+		return;
+	}
 
-	FVector DirectionToOrigin = WorldLocation - OriginLocation;
-	DirectionToOrigin.Normalize();
+	FTrickySplineSampler Sampler(*SplineComponent);
 
-	switch (Direction)
+	if (MinDistance < Sampler.GetSplineLength() * MinRelativeCurvatureStep)
 	{
-	case EPointDirection::Origin:
-		OutRotation = Origin.GetRotation().Rotator();
-		break;
-	case EPointDirection::Clockwise:
+		return;
+	}
+
+	const ESplineCoordinateSpace::Type CoordinateSpace = bUseLocalSpace
+		                                                     ? ESplineCoordinateSpace::Local
+		                                                     : ESplineCoordinateSpace::World;
+	SampleTransformsByCurvature(Sampler, MinDistance, MaxDistance, MaxAngle, CoordinateSpace, OutTransforms);
+}
+
+void UTrickyUtilityLibrary::SweepPatternAlongSpline(USplineComponent* SplineComponent,
+                                                    const FTrickyPatternSettings& Settings,
+                                                    const float Distance,
+                                                    const bool bUseLocalSpace,
+                                                    TArray<FTransform>& OutTransforms)
+{
+	TRICKY_UTILITIES_SCOPE(SweepPatternAlongSpline);
+	LLM_SCOPE_BYTAG(TrickyUtilities_PatternBuffers);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
+
+	if (!IsValid(SplineComponent) || Distance <= 0.f)
+	{
+		return;
+	}
+
+	FTrickySplineSampler Sampler(*SplineComponent);
+	const ESplineCoordinateSpace::Type CoordinateSpace = bUseLocalSpace
+		                                                     ? ESplineCoordinateSpace::Local
+		                                                     : ESplineCoordinateSpace::World;
+	const int32 FramesAmount = GetSplinePointsAmountByDistance(Sampler.GetSplineLength(), Distance) + 1;
+
+	TArray<FTransform> Frames;
+	Frames.SetNumUninitialized(FramesAmount);
+	CalculateRotationMinimizingFrames(Sampler, CoordinateSpace, Frames);
+
+	const TSharedRef<const TArray<FTransform>> LocalTransforms = FTrickyPatternCache::Get().GetLocalPattern(Settings);
+	const int32 StartIndex = OutTransforms.AddUninitialized(LocalTransforms->Num() * FramesAmount);
+	StampPatternAtOrigins(*LocalTransforms, Frames, OutTransforms.GetData() + StartIndex);
+}
+
+void UTrickyUtilityLibrary::BakeSplineToPolyline(USplineComponent* SplineComponent,
+                                                 const float Tolerance,
+                                                 const bool bUseLocalSpace,
+                                                 TArray<FVector>& OutLocations)
+{
+	TRICKY_UTILITIES_SCOPE(BakeSplineToPolyline);
+	LLM_SCOPE_BYTAG(TrickyUtilities);
+	const TTrickyOutputStatScope OutputStatScope(OutLocations);
+
+	if (!IsValid(SplineComponent) || Tolerance <= 0.f)
+	{
+		return;
+	}
+
+	const FInterpCurveVector& Position = SplineComponent->SplineCurves.Position;
+	const TArray<FInterpCurvePoint<FVector>>& Points = Position.Points;
+
+	if (Points.IsEmpty())
+	{
+		return;
+	}
+
+	// The curve is evaluated in the output space, so the tolerance isn't scaled by the component transform.
+	const FTransform CurveTransform = bUseLocalSpace ? FTransform::Identity : SplineComponent->GetComponentTransform();
+	const int32 SegmentsAmount = Position.bIsLooped ? Points.Num() : Points.Num() - 1;
+	const double ToleranceSquared = FMath::Square(Tolerance);
+	OutLocations.Emplace(CurveTransform.TransformPosition(Points[0].OutVal));
+
+	for (int32 i = 0; i < SegmentsAmount; ++i)
+	{
+		const bool bIsLoopSegment = i == Points.Num() - 1;
+		const float StartKey = Points[i].InVal;
+		const float EndKey = bIsLoopSegment ? StartKey + Position.LoopKeyOffset : Points[i + 1].InVal;
+		const FVector StartLocation = CurveTransform.TransformPosition(Points[i].OutVal);
+		const FVector EndLocation = CurveTransform.TransformPosition(Points[bIsLoopSegment ? 0 : i + 1].OutVal);
+
+		if (Points[i].InterpMode == CIM_Linear || Points[i].InterpMode == CIM_Constant)
 		{
-			const FVector TangentVector = FVector::CrossProduct(WorldUpVector, DirectionToOrigin);
-			const FMatrix RotationMatrix = FRotationMatrix::MakeFromXZ(TangentVector, WorldUpVector);
-			OutRotation = RotationMatrix.Rotator();
+			OutLocations.Emplace(EndLocation);
+			continue;
 		}
-		break;
-	case EPointDirection::CounterClockwise:
+
+		const FVector MiddleLocation = EvalBakedLocation(Position, CurveTransform, (StartKey + EndKey) * 0.5f);
+		BakeSplinePiece(Position,
+		                CurveTransform,
+		                StartKey,
+		                StartLocation,
+		                MiddleLocation,
+		                EndKey,
+		                EndLocation,
+		                ToleranceSquared,
+		                0,
+		                OutLocations);
+	}
+}
+
+void UTrickyUtilityLibrary::GetTransformsAlongSplines(const TArray<USplineComponent*>& SplineComponents,
+                                                      const TArray<FTrickySplineSamplingSettings>& Settings,
+                                                      TArray<FTransform>& OutTransforms,
+                                                      TArray<int32>& OutOffsets)
+{
+	TRICKY_UTILITIES_SCOPE(GetTransformsAlongSplines);
+	LLM_SCOPE_BYTAG(TrickyUtilities);
+	const TTrickyOutputStatScope OutputStatScope(OutTransforms);
+
+	if (SplineComponents.IsEmpty() || (Settings.Num() != 1 && Settings.Num() != SplineComponents.Num()))
+	{
+		return;
+	}
+
+	// Sizes of all ranges are known up front, so every spline can write straight into its own part of the output.
+	TArray<int32, TInlineAllocator<64>> PointsAmounts;
+	PointsAmounts.SetNumZeroed(SplineComponents.Num());
+	int32 TotalPointsAmount = 0;
+
+	for (int32 i = 0; i < SplineComponents.Num(); ++i)
+	{
+		const USplineComponent* SplineComponent = SplineComponents[i];
+		const FTrickySplineSamplingSettings& SplineSettings = Settings[Settings.Num() == 1 ? 0 : i];
+
+		if (!IsValid(SplineComponent))
 		{
-			const FVector TangentVector = FVector::CrossProduct(DirectionToOrigin, WorldUpVector);
-			const FMatrix RotationMatrix = FRotationMatrix::MakeFromXZ(TangentVector, WorldUpVector);
-			OutRotation = RotationMatrix.Rotator();
+			continue;
 		}
-		break;
-	case EPointDirection::Inside:
+
+		if (SplineSettings.SamplingMode == ESplineSamplingMode::ByPoints)
 		{
-			DirectionToOrigin = OriginLocation - WorldLocation;
-			DirectionToOrigin.Normalize();
-			const FMatrix RotationMatrix = FRotationMatrix::MakeFromXZ(DirectionToOrigin, WorldUpVector);
-			OutRotation = RotationMatrix.Rotator();
+			PointsAmounts[i] = FMath::Max(0, SplineSettings.PointsAmount);
 		}
-		break;
-	case EPointDirection::Outside:
+		else if (SplineSettings.Distance > 0.f)
 		{
-			const FMatrix RotationMatrix = FRotationMatrix::MakeFromXZ(DirectionToOrigin, WorldUpVector);
-			OutRotation = RotationMatrix.Rotator();
+			PointsAmounts[i] = GetSplinePointsAmountByDistance(SplineComponent->GetSplineLength(),
+			                                                   SplineSettings.Distance);
 		}
-		break;
+
+		TotalPointsAmount += PointsAmounts[i];
+	}
+
+	const int32 StartIndex = OutTransforms.AddUninitialized(TotalPointsAmount);
+	const int32 FirstOffset = OutOffsets.AddUninitialized(SplineComponents.Num());
+
+	for (int32 i = 0, Offset = StartIndex; i < SplineComponents.Num(); ++i)
+	{
+		OutOffsets[FirstOffset + i] = Offset;
+		Offset += PointsAmounts[i];
+	}
+
+	// The game thread waits for the workers, so the curves of the components can be read without copying them.
+	ParallelFor(SplineComponents.Num(), [&](const int32 Index)
+	{
+		if (PointsAmounts[Index] == 0)
+		{
+			return;
+		}
+
+		const FTrickySplineSamplingSettings& SplineSettings = Settings[Settings.Num() == 1 ? 0 : Index];
+		const ESplineCoordinateSpace::Type CoordinateSpace = SplineSettings.bUseLocalSpace
+			                                                     ? ESplineCoordinateSpace::Local
+			                                                     : ESplineCoordinateSpace::World;
+		const TArrayView<FTransform> SplineTransforms(OutTransforms.GetData() + OutOffsets[FirstOffset + Index],
+		                                              PointsAmounts[Index]);
+		FTrickySplineSampler Sampler(*SplineComponents[Index]);
+
+		if (SplineSettings.SamplingMode == ESplineSamplingMode::ByPoints)
+		{
+			SampleTransformsByPoints(Sampler, CoordinateSpace, SplineTransforms);
+		}
+		else
+		{
+			SampleTransformsByDistance(Sampler, SplineSettings.Distance, CoordinateSpace, SplineTransforms);
+		}
+	});
+}
+
+void UTrickyUtilityLibrary::AsyncGetTransformsAlongSplineByPoints(UObject* WorldContextObject,
+                                                                  USplineComponent* SplineComponent,
+                                                                  const int32 PointsAmount,
+                                                                  const bool bUseLocalSpace,
+                                                                  FLatentActionInfo LatentInfo,
+                                                                  TArray<FTransform>& OutTransforms)
+{
+	TRICKY_UTILITIES_SCOPE(AsyncGetTransformsAlongSplineByPoints);
+	LLM_SCOPE_BYTAG(TrickyUtilities);
+
+	AddSplineSamplingLatentAction(WorldContextObject,
+	                              GetTransformsAlongSplineByPointsAsync(SplineComponent, PointsAmount, bUseLocalSpace),
+	                              OutTransforms,
+	                              LatentInfo);
+}
+
+void UTrickyUtilityLibrary::AsyncGetTransformsAlongSplineByDistance(UObject* WorldContextObject,
+                                                                    USplineComponent* SplineComponent,
+                                                                    const float Distance,
+                                                                    const bool bUseLocalSpace,
+                                                                    FLatentActionInfo LatentInfo,
+                                                                    TArray<FTransform>& OutTransforms)
+{
+	TRICKY_UTILITIES_SCOPE(AsyncGetTransformsAlongSplineByDistance);
+	LLM_SCOPE_BYTAG(TrickyUtilities);
+
+	AddSplineSamplingLatentAction(WorldContextObject,
+	                              GetTransformsAlongSplineByDistanceAsync(SplineComponent, Distance, bUseLocalSpace),
+	                              OutTransforms,
+	                              LatentInfo);
+}
+
+TFuture<TArray<FTransform>> UTrickyUtilityLibrary::GetTransformsAlongSplineByPointsAsync(
+	USplineComponent* SplineComponent,
+	const int32 PointsAmount,
+	const bool bUseLocalSpace)
+{
+	TRICKY_UTILITIES_SCOPE(GetTransformsAlongSplineByPointsAsync);
+	LLM_SCOPE_BYTAG(TrickyUtilities);
+
+	if (!IsValid(SplineComponent) || PointsAmount <= 0)
+	{
+		return MakeFulfilledPromise<TArray<FTransform>>().GetFuture();
+	}
+
+	return SampleSplineAsync(*SplineComponent,
+	                         bUseLocalSpace,
+	                         [PointsAmount](FTrickySplineSampler& Sampler,
+	                                        const ESplineCoordinateSpace::Type CoordinateSpace,
+	                                        TArray<FTransform>& OutTransforms)
+	                         {
+		                         SampleTransformsByPoints(Sampler,
+		                                                  CoordinateSpace,
+		                                                  AddTransforms(OutTransforms, PointsAmount));
+	                         });
+}
+
+TFuture<TArray<FTransform>> UTrickyUtilityLibrary::GetTransformsAlongSplineByDistanceAsync(
+	USplineComponent* SplineComponent,
+	const float Distance,
+	const bool bUseLocalSpace)
+{
+	TRICKY_UTILITIES_SCOPE(GetTransformsAlongSplineByDistanceAsync);
+	LLM_SCOPE_BYTAG(TrickyUtilities);
+
+	if (!IsValid(SplineComponent) || Distance <= 0.f)
+	{
+		return MakeFulfilledPromise<TArray<FTransform>>().GetFuture();
 	}
+
+	return SampleSplineAsync(*SplineComponent,
+	                         bUseLocalSpace,
+	                         [Distance](FTrickySplineSampler& Sampler,
+	                                    const ESplineCoordinateSpace::Type CoordinateSpace,
+	                                    TArray<FTransform>& OutTransforms)
+	                         {
+		                         const int32 PointsAmount = GetSplinePointsAmountByDistance(Sampler.GetSplineLength(),
+		                                                                                    Distance);
+		                         SampleTransformsByDistance(Sampler,
+		                                                    Distance,
+		                                                    CoordinateSpace,
+		                                                    AddTransforms(OutTransforms, PointsAmount));
+	                         });
 }
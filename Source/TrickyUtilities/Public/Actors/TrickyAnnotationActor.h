@@ -9,7 +9,10 @@
 
 enum EHorizTextAligment : int;
 enum EVerticalTextAligment : int;
+class UStaticMesh;
 class UTextRenderComponent;
+class UTrickyAnnotationBackgroundComponent;
+class UTrickyAnnotationSubsystem;
 
 /**
  * A customizable annotation actor used for displaying a custom text.
@@ -27,7 +30,19 @@ public:
 protected:
 	virtual void OnConstruction(const FTransform& Transform) override;
 
+	virtual void PreRegisterAllComponents() override;
+
+	virtual void PostRegisterAllComponents() override;
+
+	virtual void PostUnregisterAllComponents() override;
+
 public:
+	virtual void SetActorHiddenInGame(bool bNewHidden) override;
+
+#if WITH_EDITOR
+	virtual void SetIsTemporarilyHiddenInEditor(bool bIsHidden) override;
+#endif
+
 	UFUNCTION(BlueprintGetter, Category = "TrickyAnnotation")
 	FText GetAnnotationText() const { return AnnotationText; };
 
@@ -40,12 +55,28 @@ public:
 	UFUNCTION(BlueprintSetter, Category = "TrickyAnnotation")
 	void SetTextColor(const FColor& NewColor);
 
+	/**
+	 * Appends world transforms of the front and back backgrounds.
+	 * Backgrounds of a hidden actor get a zero scale.
+	 */
+	void GetBackgroundTransforms(TArray<FTransform>& OutTransforms) const;
+
+	/**
+	 * Gets the mesh and material shared by the front and back backgrounds.
+	 *
+	 * @return False if the backgrounds use different meshes or materials or have no mesh.
+	 */
+	bool GetBackgroundMeshAndMaterial(UStaticMesh*& OutMesh, UMaterialInterface*& OutMaterial) const;
+
+	/** Returns the front background for 0 and the back one for 1, in the order of GetBackgroundTransforms. */
+	UStaticMeshComponent* GetBackgroundComponent(const int32 Index) const;
+
 protected:
 	UPROPERTY()
-	TObjectPtr<UStaticMeshComponent> FrontMeshComponent = nullptr;
+	TObjectPtr<UTrickyAnnotationBackgroundComponent> FrontMeshComponent = nullptr;
 
 	UPROPERTY()
-	TObjectPtr<UStaticMeshComponent> BackMeshComponent = nullptr;
+	TObjectPtr<UTrickyAnnotationBackgroundComponent> BackMeshComponent = nullptr;
 
 	UPROPERTY()
 	TObjectPtr<UTextRenderComponent> FrontTextComponent = nullptr;
@@ -104,6 +135,44 @@ private:
 	const float DisplacementFactor = 0.5f;
 
 	const float TextOffset = 0.25f;
+
+	/**
+	 * Property values applied to the components by the last construction.
+	 * OnConstruction compares against them to skip updates of unchanged properties,
+	 * e.g. while the actor is only being moved in the editor.
+	 */
+	bool bHasAppliedProperties = false;
+
+	FString AppliedText;
+
+	int32 AppliedTextSize = 0;
+
+	FColor AppliedTextColor = FColor::White;
+
+	TEnumAsByte<EVerticalTextAligment> AppliedVerticalAlignment = EVerticalTextAligment::EVRTA_TextCenter;
+
+	TEnumAsByte<EHorizTextAligment> AppliedHorizontalAlignment = EHorizTextAligment::EHTA_Center;
+
+	TWeakObjectPtr<UMaterialInterface> AppliedTextMaterial = nullptr;
+
+	void StoreAppliedProperties();
+
+	/** Subsystem rendering the backgrounds, if not set the background components are rendered instead. */
+	TWeakObjectPtr<UTrickyAnnotationSubsystem> AnnotationSubsystem = nullptr;
+
+	FDelegateHandle TransformUpdatedHandle;
+
+	/**
+	 * Registers the backgrounds in the annotation subsystem.
+	 * If it accepted them, the background components stop creating render proxies.
+	 */
+	void UpdateBackgroundsBatching();
+
+	void MarkBackgroundsDirty();
+
+	void OnRootTransformUpdated(USceneComponent* UpdatedComponent,
+	                            EUpdateTransformFlags UpdateTransformFlags,
+	                            ETeleportType Teleport);
 	
 	UFUNCTION()
 	void UpdateTextProperties(UTextRenderComponent* Component,
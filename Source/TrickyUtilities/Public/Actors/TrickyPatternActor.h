@@ -0,0 +1,67 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "TrickyUtilityLibrary.h"
+#include "TrickyPatternActor.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+
+/**
+ * An actor which places instances of a static mesh using one of the pattern generators of UTrickyUtilityLibrary.
+ * Instances are submitted to the instanced mesh component in batches.
+ */
+UCLASS(HideCategories=(Collision, Input, Replication, HLOD, Physics, Networking, LevelInstance))
+class TRICKYUTILITIES_API ATrickyPatternActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ATrickyPatternActor();
+
+protected:
+	virtual void OnConstruction(const FTransform& Transform) override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+public:
+	UFUNCTION(BlueprintGetter, Category="TrickyPattern")
+	FTrickyPatternSettings GetPatternSettings() const { return PatternSettings; }
+
+	UFUNCTION(BlueprintSetter, Category="TrickyPattern")
+	void SetPatternSettings(const FTrickyPatternSettings& NewSettings);
+
+	/**
+	 * Generates the pattern using current settings and applies it to the instanced mesh component.
+	 * Instances are compared with the previous pattern by index and only the differing ones are updated,
+	 * added or removed. Changes which move every point, e.g. of the points amount or radius, update all instances.
+	 * While a property is dragged in the editor the tree of the instanced mesh component isn't rebuilt,
+	 * it's built once when the value is set.
+	 */
+	UFUNCTION(BlueprintCallable, Category="TrickyPattern")
+	void RegeneratePattern();
+
+protected:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
+	TObjectPtr<UHierarchicalInstancedStaticMeshComponent> InstancedMeshComponent = nullptr;
+
+	/**
+	 * Pattern used to place the instances in the local space of the actor.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintGetter=GetPatternSettings,
+		BlueprintSetter=SetPatternSettings,
+		Category="TrickyPattern")
+	FTrickyPatternSettings PatternSettings;
+
+private:
+	/** Transforms of the instances applied during the last regeneration. */
+	UPROPERTY(Transient)
+	TArray<FTransform> InstanceTransforms;
+
+	void ApplyInstanceTransforms(const TArray<FTransform>& NewTransforms);
+};
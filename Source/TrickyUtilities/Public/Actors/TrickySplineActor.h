@@ -4,10 +4,18 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "TrickySplineLookupTable.h"
+#include "TrickySplineSegmentTree.h"
 #include "TrickySplineActor.generated.h"
 
 class USplineComponent;
 
+/**
+ * An actor with a spline component as root.
+ * Keeps a uniformly spaced arc length lookup table of the spline for fast queries by distance.
+ * The table is built lazily by the first query after construction or MarkLookupTableDirty.
+ * Closest point queries use a segment tree built over the table on the first query after every rebuild.
+ */
 UCLASS()
 class TRICKYUTILITIES_API ATrickySplineActor : public AActor
 {
@@ -16,7 +24,122 @@ class TRICKYUTILITIES_API ATrickySplineActor : public AActor
 public:
 	ATrickySplineActor();
 
+protected:
+	virtual void OnConstruction(const FTransform& Transform) override;
+
+public:
+	USplineComponent* GetSplineComponent() const { return SplineComponent; }
+
+	/**
+	 * Forces the lookup table to be rebuilt on the next query.
+	 * Must be called after modifying the spline points at runtime.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TrickySpline")
+	void MarkLookupTableDirty();
+
+	/** Immediately rebuilds the lookup table. */
+	UFUNCTION(BlueprintCallable, Category = "TrickySpline")
+	void RebuildLookupTable();
+
+	/** Returns the lookup table of the spline in its local space, rebuilding it if it's dirty. */
+	const FTrickySplineLookupTable& GetLookupTable();
+
+	/**
+	 * Returns a location on the spline at the given distance using the lookup table.
+	 *
+	 * @param Distance Distance along the spline. Clamped to the spline length.
+	 * @param bUseLocalSpace If true, local space will be used, otherwise world space.
+	 */
+	UFUNCTION(BlueprintPure, Category = "TrickySpline")
+	FVector GetLocationAtDistance(const float Distance, const bool bUseLocalSpace = false);
+
+	/**
+	 * Returns a normalized direction of the spline at the given distance using the lookup table.
+	 *
+	 * @param Distance Distance along the spline. Clamped to the spline length.
+	 * @param bUseLocalSpace If true, local space will be used, otherwise world space.
+	 */
+	UFUNCTION(BlueprintPure, Category = "TrickySpline")
+	FVector GetDirectionAtDistance(const float Distance, const bool bUseLocalSpace = false);
+
+	/**
+	 * Returns an up vector of the spline at the given distance using the lookup table.
+	 *
+	 * @param Distance Distance along the spline. Clamped to the spline length.
+	 * @param bUseLocalSpace If true, local space will be used, otherwise world space.
+	 */
+	UFUNCTION(BlueprintPure, Category = "TrickySpline")
+	FVector GetUpVectorAtDistance(const float Distance, const bool bUseLocalSpace = false);
+
+	/**
+	 * Returns a roll of the spline in degrees at the given distance using the lookup table.
+	 *
+	 * @param Distance Distance along the spline. Clamped to the spline length.
+	 * @param bUseLocalSpace If true, local space will be used, otherwise world space.
+	 */
+	UFUNCTION(BlueprintPure, Category = "TrickySpline")
+	float GetRollAtDistance(const float Distance, const bool bUseLocalSpace = false);
+
+	/**
+	 * Returns a transform of the spline at the given distance using the lookup table.
+	 *
+	 * @param Distance Distance along the spline. Clamped to the spline length.
+	 * @param bUseLocalSpace If true, local space will be used, otherwise world space.
+	 */
+	UFUNCTION(BlueprintPure, Category = "TrickySpline")
+	FTransform GetTransformAtDistance(const float Distance, const bool bUseLocalSpace = false);
+
+	/** Returns the segment tree of the lookup table, rebuilding it if it's dirty. */
+	const FTrickySplineSegmentTree& GetSegmentTree();
+
+	/**
+	 * Finds the point on the spline closest to the given location using the segment tree.
+	 *
+	 * @param Location Location to find the closest point for.
+	 * @param bUseLocalSpace If true, locations are in local space, otherwise in world space.
+	 * @param OutDistance Distance along the spline to the closest point.
+	 * @param OutLocation The closest point on the spline.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TrickySpline")
+	void FindClosestPointToLocation(const FVector& Location,
+	                                const bool bUseLocalSpace,
+	                                float& OutDistance,
+	                                FVector& OutLocation);
+
+	/**
+	 * Finds the points on the spline closest to every given location on worker threads.
+	 *
+	 * @param Locations Locations to find the closest points for.
+	 * @param bUseLocalSpace If true, locations are in local space, otherwise in world space.
+	 * @param OutDistances An array that will store distances along the spline to the closest points.
+	 * @param OutLocations An array that will store the closest points on the spline.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TrickySpline")
+	void FindClosestPointsToLocations(const TArray<FVector>& Locations,
+	                                  const bool bUseLocalSpace,
+	                                  TArray<float>& OutDistances,
+	                                  TArray<FVector>& OutLocations);
+
 protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	TObjectPtr<USplineComponent> SplineComponent = nullptr;
+
+	/**
+	 * Maximal distance between two samples of the lookup table.
+	 * Smaller values give more precise queries at the cost of memory.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadOnly,
+		Category = "TrickySpline",
+		meta=(ClampMin=1, UIMin=1, Units="Centimeters"))
+	float LookupTableStep = 10.f;
+
+private:
+	FTrickySplineLookupTable LookupTable;
+
+	bool bIsLookupTableDirty = true;
+
+	FTrickySplineSegmentTree SegmentTree;
+
+	bool bIsSegmentTreeDirty = true;
 };
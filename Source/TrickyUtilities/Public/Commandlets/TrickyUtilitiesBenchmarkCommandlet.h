@@ -0,0 +1,25 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TrickyUtilitiesBenchmarkCommandlet.generated.h"
+
+/**
+ * Measures the pattern generators and the spline samplers of UTrickyUtilityLibrary for sizes from 10 to 1M points.
+ * Reports time per point, allocations per call and peak memory, and writes them into a CSV file
+ * in Saved/TrickyUtilities, so results of different plugin versions can be compared.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=TrickyUtilitiesBenchmark -nullrhi [-MaxPoints=N] [-Filter=Name]
+ */
+UCLASS()
+class TRICKYUTILITIES_API UTrickyUtilitiesBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTrickyUtilitiesBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
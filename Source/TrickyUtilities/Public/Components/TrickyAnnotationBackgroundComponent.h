@@ -0,0 +1,28 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/StaticMeshComponent.h"
+#include "TrickyAnnotationBackgroundComponent.generated.h"
+
+/**
+ * A background of an annotation actor which doesn't create a render proxy while its annotation is rendered
+ * by UTrickyAnnotationSubsystem, leaving the saved visibility of the component untouched.
+ */
+UCLASS(ClassGroup=(TrickyUtilities))
+class TRICKYUTILITIES_API UTrickyAnnotationBackgroundComponent : public UStaticMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+
+	bool IsRenderedByBatch() const { return bIsRenderedByBatch; }
+
+	void SetRenderedByBatch(const bool bNewRenderedByBatch);
+
+private:
+	/** Set at runtime by the owning annotation, so it's never saved. */
+	bool bIsRenderedByBatch = false;
+};
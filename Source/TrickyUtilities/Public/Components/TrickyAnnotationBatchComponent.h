@@ -0,0 +1,24 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "TrickyAnnotationBatchComponent.generated.h"
+
+/**
+ * Renders backgrounds of many annotation actors as instances for UTrickyAnnotationSubsystem.
+ * In the editor every instance gets a hit proxy of its annotation, so clicking a background selects the annotation.
+ */
+UCLASS(ClassGroup=(TrickyUtilities))
+class TRICKYUTILITIES_API UTrickyAnnotationBatchComponent : public UInstancedStaticMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+	UTrickyAnnotationBatchComponent();
+
+#if WITH_EDITOR
+	virtual void CreateHitProxyData(TArray<TRefCountPtr<HHitProxy>>& HitProxies) override;
+#endif
+};
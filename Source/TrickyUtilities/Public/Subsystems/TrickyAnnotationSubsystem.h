@@ -0,0 +1,105 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "TrickyAnnotationSubsystem.generated.h"
+
+class ATrickyAnnotationActor;
+class UTrickyAnnotationBatchComponent;
+class UMaterialInterface;
+class UStaticMesh;
+
+/** Backgrounds of annotations which use the same mesh and material, rendered by one instanced mesh component. */
+USTRUCT()
+struct FTrickyAnnotationBackgroundBatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TObjectPtr<UTrickyAnnotationBatchComponent> Component = nullptr;
+
+	TObjectKey<UStaticMesh> Mesh;
+
+	TObjectKey<UMaterialInterface> Material;
+
+	/**
+	 * Annotations of the batch, instances 2 * i and 2 * i + 1 belong to the i-th one.
+	 * Removing an annotation moves the last one into its slot.
+	 */
+	TArray<TWeakObjectPtr<ATrickyAnnotationActor>> Annotations;
+
+	/** Amount of leading annotations which already have instances, the rest get them during the next tick. */
+	int32 InstancedAmount = 0;
+
+	/** Indices of instanced annotations which backgrounds have to be updated. */
+	TSet<int32> DirtyIndices;
+};
+
+/**
+ * Renders backgrounds of all annotation actors in the world as instances of instanced mesh components,
+ * one per background mesh and material, so thousands of annotations cost a few background primitives
+ * instead of two per annotation.
+ * Annotations register themselves and mark their backgrounds dirty, instances are updated once per tick.
+ * Text render components can't be merged, so every annotation keeps rendering its own text.
+ */
+UCLASS()
+class TRICKYUTILITIES_API UTrickyAnnotationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickableInEditor() const override { return true; }
+
+	virtual bool IsTickableWhenPaused() const override { return true; }
+
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Returns the subsystem which should render annotation backgrounds in the given world
+	 * or nullptr if annotations have to render them on their own.
+	 * Batching can be disabled with TrickyUtilities.BatchAnnotationBackgrounds.
+	 */
+	static UTrickyAnnotationSubsystem* GetBatchingSubsystem(const UWorld* World);
+
+	/**
+	 * Adds the annotation to the batch of its background mesh and material,
+	 * or moves it to another batch if they changed since the last call.
+	 *
+	 * @return False if the backgrounds of the annotation can't be batched and it has to render them on its own.
+	 */
+	bool RegisterAnnotation(ATrickyAnnotationActor* Annotation);
+
+	void UnregisterAnnotation(ATrickyAnnotationActor* Annotation);
+
+	/** Updates background instances of the given annotation during the next tick. */
+	void MarkAnnotationDirty(ATrickyAnnotationActor* Annotation);
+
+	/**
+	 * Returns the annotation at the given index of the batch rendered by the given component.
+	 *
+	 * @return Nullptr if the annotation was destroyed or doesn't have instances yet.
+	 */
+	ATrickyAnnotationActor* GetBatchedAnnotation(const UTrickyAnnotationBatchComponent* Component,
+	                                             const int32 Index) const;
+
+	UFUNCTION(BlueprintPure, Category="TrickyAnnotation")
+	int32 GetAnnotationsAmount() const { return AnnotationSlots.Num(); }
+
+private:
+	UPROPERTY(Transient)
+	TArray<FTrickyAnnotationBackgroundBatch> Batches;
+
+	/** Batch index and index inside of the batch of every registered annotation. */
+	TMap<TObjectKey<ATrickyAnnotationActor>, FIntPoint> AnnotationSlots;
+
+	int32 FindOrAddBatch(UStaticMesh* Mesh, UMaterialInterface* Material);
+
+	void UpdateBatch(FTrickyAnnotationBackgroundBatch& Batch);
+};
@@ -0,0 +1,90 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TrickySplineFollowerSubsystem.generated.h"
+
+class ATrickySplineActor;
+
+/**
+ * Moves scene components along spline actors in a single tick instead of ticking every mover on its own.
+ * Distances and speeds of all followers are stored in packed arrays and advanced together
+ * using the lookup tables of the splines, the results are then applied to the components in one pass.
+ */
+UCLASS()
+class TRICKYUTILITIES_API UTrickySplineFollowerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Starts moving the given component along the spline.
+	 *
+	 * @param SplineActor Spline to follow. Must be a valid instance.
+	 * @param Target Component which will be moved. Must be a valid instance.
+	 * @param Speed Speed along the spline in units per second. Negative values move the follower backwards.
+	 * @param StartDistance Distance along the spline the follower starts at.
+	 * @param bLoop If true, the follower wraps around the spline ends, otherwise it stops at them.
+	 * @return Id of the follower or INDEX_NONE if it wasn't added.
+	 */
+	UFUNCTION(BlueprintCallable, Category="TrickySplineFollower")
+	int32 AddFollower(ATrickySplineActor* SplineActor,
+	                  USceneComponent* Target,
+	                  const float Speed,
+	                  const float StartDistance = 0.f,
+	                  const bool bLoop = true);
+
+	UFUNCTION(BlueprintCallable, Category="TrickySplineFollower")
+	void RemoveFollower(const int32 FollowerId);
+
+	UFUNCTION(BlueprintCallable, Category="TrickySplineFollower")
+	void SetFollowerSpeed(const int32 FollowerId, const float Speed);
+
+	UFUNCTION(BlueprintPure, Category="TrickySplineFollower")
+	float GetFollowerDistance(const int32 FollowerId) const;
+
+	UFUNCTION(BlueprintPure, Category="TrickySplineFollower")
+	int32 GetFollowersAmount() const { return Distances.Num(); }
+
+private:
+	/**
+	 * Packed data of the followers, all arrays have the same size.
+	 * Removing a follower moves the last one into its slot.
+	 */
+	TArray<float> Distances;
+
+	TArray<float> Speeds;
+
+	TArray<bool> Loops;
+
+	TArray<int32> SplineIndices;
+
+	TArray<TWeakObjectPtr<USceneComponent>> Targets;
+
+	TArray<int32> FollowerIds;
+
+	/** Index of every follower in the packed arrays by its id. */
+	TMap<int32, int32> FollowerIndices;
+
+	/**
+	 * Splines followed by any follower, referenced by SplineIndices.
+	 * A spline is removed once its last follower is removed, moving the last spline into its slot.
+	 */
+	TArray<TWeakObjectPtr<ATrickySplineActor>> Splines;
+
+	/** Amount of followers of every spline in Splines. */
+	TArray<int32> SplineFollowersAmounts;
+
+	/** World transforms calculated during the last tick. */
+	TArray<FTransform> FollowerTransforms;
+
+	int32 NextFollowerId = 0;
+
+	void RemoveFollowerAt(const int32 Index);
+};
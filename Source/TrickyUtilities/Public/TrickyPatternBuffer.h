@@ -0,0 +1,67 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TrickyPatternBuffer.generated.h"
+
+/**
+ * Structure of arrays storage for generated patterns.
+ * Locations, rotations and scales are kept in separate contiguous arrays,
+ * so passes which read only locations don't have to stream whole transforms.
+ */
+USTRUCT(BlueprintType)
+struct TRICKYUTILITIES_API FTrickyPatternBuffer
+{
+	GENERATED_BODY()
+
+	FTrickyPatternBuffer() = default;
+
+	explicit FTrickyPatternBuffer(const bool bInStoreScales)
+		: bStoreScales(bInStoreScales)
+	{
+	}
+
+	/**
+	 * If true, point scales will be written into the Scales array.
+	 * Otherwise, Scales stays empty and every point is treated as having a unit scale.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="TrickyPatternBuffer")
+	bool bStoreScales = false;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="TrickyPatternBuffer")
+	TArray<FVector> Locations;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="TrickyPatternBuffer")
+	TArray<FQuat> Rotations;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="TrickyPatternBuffer")
+	TArray<FVector> Scales;
+
+	int32 Num() const { return Locations.Num(); }
+
+	bool IsEmpty() const { return Locations.IsEmpty(); }
+
+	/** Removes all points, keeping the allocated memory. */
+	void Reset();
+
+	/** Makes sure the buffer can hold the given amount of points without reallocating. */
+	void Reserve(const int32 PointsAmount);
+
+	/**
+	 * Appends the given amount of uninitialized points.
+	 *
+	 * @return Index of the first added point.
+	 */
+	int32 AddUninitialized(const int32 PointsAmount);
+
+	/** Builds a transform of the point with the given index. */
+	FTransform GetTransform(const int32 Index) const;
+
+	/**
+	 * Appends all points of the buffer to an array of transforms.
+	 *
+	 * @param OutTransforms An array that will store the resulting transforms.
+	 */
+	void GetTransforms(TArray<FTransform>& OutTransforms) const;
+};
@@ -0,0 +1,68 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/List.h"
+#include "TrickyUtilityLibrary.h"
+
+/**
+ * Process wide cache of local space patterns keyed by their generator settings.
+ * On a hit only the origin transform is applied to the stored pattern.
+ * The least recently used patterns are evicted once the memory budget set by
+ * TrickyUtilities.PatternCacheBudgetKB is exceeded.
+ */
+class TRICKYUTILITIES_API FTrickyPatternCache
+{
+public:
+	static FTrickyPatternCache& Get();
+
+	/**
+	 * Returns the local space pattern for the given settings, generating it on a miss.
+	 * The returned array is shared and must not be modified.
+	 */
+	TSharedRef<const TArray<FTransform>> GetLocalPattern(const FTrickyPatternSettings& Settings);
+
+	/**
+	 * Appends the pattern for the given settings moved to the given origin.
+	 *
+	 * @param Origin Centre of the pattern.
+	 * @param Settings Pattern type and parameters of its generator.
+	 * @param OutTransforms An array that will store the resulting transforms.
+	 */
+	void CalculatePatternTransforms(const FTransform& Origin,
+	                                const FTrickyPatternSettings& Settings,
+	                                TArray<FTransform>& OutTransforms);
+
+	/** Removes all stored patterns and resets the counters. */
+	void Reset();
+
+	int64 GetUsedBytes() const;
+
+	int64 GetHitsAmount() const;
+
+	int64 GetMissesAmount() const;
+
+private:
+	struct FEntry
+	{
+		TSharedPtr<const TArray<FTransform>> Transforms;
+		int64 SizeBytes = 0;
+		TDoubleLinkedList<FTrickyPatternSettings>::TDoubleLinkedListNode* LruNode = nullptr;
+	};
+
+	mutable FCriticalSection CriticalSection;
+
+	TMap<FTrickyPatternSettings, FEntry> Entries;
+
+	/** Settings of the stored patterns, the most recently used are at the head. */
+	TDoubleLinkedList<FTrickyPatternSettings> LruList;
+
+	int64 UsedBytes = 0;
+
+	int64 HitsAmount = 0;
+
+	int64 MissesAmount = 0;
+
+	void EvictToBudget(const int64 BudgetBytes);
+};
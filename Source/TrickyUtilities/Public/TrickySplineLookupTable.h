@@ -0,0 +1,64 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FSplineCurves;
+
+/**
+ * Uniformly spaced arc length lookup table of a spline in its local space.
+ * Samples are stored in separate arrays and every query interpolates between two neighbouring samples,
+ * so the cost of a query doesn't depend on the length or the amount of points of the spline.
+ */
+struct TRICKYUTILITIES_API FTrickySplineLookupTable
+{
+	TArray<FVector> Locations;
+
+	/** Normalized directions of the spline. */
+	TArray<FVector> Directions;
+
+	TArray<FVector> UpVectors;
+
+	/** Roll of the spline rotation in degrees. */
+	TArray<float> Rolls;
+
+	/**
+	 * Samples the given spline curves.
+	 *
+	 * @param SplineCurves Curves of the spline.
+	 * @param DefaultUpVector Up vector of the spline component.
+	 * @param MaxSampleStep Maximal distance between two samples. Will be shortened to fit the spline length evenly.
+	 */
+	void Build(const FSplineCurves& SplineCurves, const FVector& DefaultUpVector, const float MaxSampleStep);
+
+	void Reset();
+
+	int32 Num() const { return Locations.Num(); }
+
+	bool IsEmpty() const { return Locations.IsEmpty(); }
+
+	float GetSplineLength() const { return SplineLength; }
+
+	float GetSampleStep() const { return SampleStep; }
+
+	FVector GetLocationAtDistance(const float Distance) const;
+
+	FVector GetDirectionAtDistance(const float Distance) const;
+
+	FVector GetUpVectorAtDistance(const float Distance) const;
+
+	float GetRollAtDistance(const float Distance) const;
+
+	FTransform GetTransformAtDistance(const float Distance) const;
+
+private:
+	float SplineLength = 0.f;
+
+	float SampleStep = 0.f;
+
+	float InverseSampleStep = 0.f;
+
+	/** Finds the sample preceding the given distance and the interpolation alpha towards the next one. */
+	void GetSampleIndex(const float Distance, int32& OutIndex, float& OutAlpha) const;
+};
@@ -0,0 +1,93 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SplineComponent.h"
+
+/**
+ * Samples a spline at increasing distances without searching its curves from scratch on every call.
+ * Every curve keeps a cursor on the segment of the last sample, so walking the spline from its start
+ * to its end costs O(samples + segments) instead of O(samples * log(segments)).
+ * Samples at decreasing distances are still correct, they just fall back to a binary search.
+ * Results are identical to the matching USplineComponent functions.
+ *
+ * The sampler only references the spline curves, they must outlive it and stay unchanged while it's used.
+ */
+class TRICKYUTILITIES_API FTrickySplineSampler
+{
+public:
+	explicit FTrickySplineSampler(const USplineComponent& SplineComponent);
+
+	FTrickySplineSampler(const FSplineCurves& InSplineCurves,
+	                     const FVector& InDefaultUpVector,
+	                     const FTransform& InComponentTransform);
+
+	float GetSplineLength() const;
+
+	/** Moves all cursors back to the start of the spline. */
+	void Reset();
+
+	/** Same as USplineComponent::GetInputKeyValueAtDistanceAlongSpline. */
+	float GetInputKeyAtDistance(const float Distance);
+
+	/** Same as USplineComponent::GetLocationAtDistanceAlongSpline. */
+	FVector GetLocationAtDistance(const float Distance, const ESplineCoordinateSpace::Type CoordinateSpace);
+
+	/** Same as USplineComponent::GetDirectionAtDistanceAlongSpline. */
+	FVector GetDirectionAtDistance(const float Distance, const ESplineCoordinateSpace::Type CoordinateSpace);
+
+	/** Same as USplineComponent::GetTransformAtDistanceAlongSpline without scale. */
+	FTransform GetTransformAtDistance(const float Distance, const ESplineCoordinateSpace::Type CoordinateSpace);
+
+private:
+	/** Cached segment of an interp curve containing the last evaluated input value. */
+	template <typename T>
+	struct TCurveCursor
+	{
+		int32 PointIndex = INDEX_NONE;
+
+		bool bIsValid = false;
+
+		bool bIsPastLoop = false;
+
+		bool bInterpolates = false;
+
+		bool bIsLinear = false;
+
+		float StartKey = 0.f;
+
+		float KeyRange = 0.f;
+
+		T StartValue;
+
+		T LeaveTangent;
+
+		T EndValue;
+
+		T ArriveTangent;
+
+		/** Value and derivative used when the cursor is outside of the interpolated range. */
+		T ConstantValue;
+
+		T ConstantDerivative;
+
+		void Seek(const FInterpCurve<T>& Curve, const float InKey, const T& Default);
+
+		T Eval(const float InKey) const;
+
+		T EvalDerivative(const float InKey) const;
+	};
+
+	const FSplineCurves& SplineCurves;
+
+	FVector DefaultUpVector = FVector::UpVector;
+
+	FTransform ComponentTransform = FTransform::Identity;
+
+	TCurveCursor<float> ReparamCursor;
+
+	TCurveCursor<FVector> PositionCursor;
+
+	TCurveCursor<FQuat> RotationCursor;
+};
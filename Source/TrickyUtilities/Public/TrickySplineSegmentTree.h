@@ -0,0 +1,56 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FTrickySplineLookupTable;
+
+/**
+ * Bounding volume hierarchy over the segments of a spline lookup table.
+ * Consecutive segments of a spline are close to each other, so every node simply covers a contiguous range of
+ * segments and is split in half, which gives tight bounds without sorting.
+ * Closest point queries visit only nodes which can contain a closer segment than the best one found so far.
+ */
+struct TRICKYUTILITIES_API FTrickySplineSegmentTree
+{
+	/** Builds the tree over the locations of the given lookup table. */
+	void Build(const FTrickySplineLookupTable& LookupTable);
+
+	void Reset();
+
+	bool IsEmpty() const { return Nodes.IsEmpty(); }
+
+	/**
+	 * Finds the point on the spline closest to the given location.
+	 * The spline is approximated by the segments of the lookup table it was built from.
+	 *
+	 * @param Location Location in the local space of the spline.
+	 * @param OutDistance Distance along the spline to the closest point.
+	 * @param OutLocation The closest point in the local space of the spline.
+	 * @return False if the tree is empty.
+	 */
+	bool FindClosestPoint(const FVector& Location, float& OutDistance, FVector& OutLocation) const;
+
+private:
+	struct FNode
+	{
+		FBox Bounds = FBox(ForceInit);
+
+		int32 FirstSegment = 0;
+
+		int32 SegmentsAmount = 0;
+
+		/** Index of the second child. The first child always follows its parent. INDEX_NONE for leaves. */
+		int32 SecondChild = INDEX_NONE;
+	};
+
+	TArray<FNode> Nodes;
+
+	/** Locations of the lookup table samples, segment i connects Points[i] and Points[i + 1]. */
+	TArray<FVector> Points;
+
+	float SegmentLength = 0.f;
+
+	int32 BuildNode(const int32 FirstSegment, const int32 SegmentsAmount);
+};
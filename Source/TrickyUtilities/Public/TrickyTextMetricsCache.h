@@ -0,0 +1,67 @@
+﻿// MIT License Copyright (c) Artyom "Tricky Fat Cat" Volkov
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UFont;
+class UTextRenderComponent;
+
+/**
+ * Process wide cache of text render component sizes keyed by their text, font and scales,
+ * so identical labels are laid out only once.
+ * Only game thread calls use the stored sizes. All entries are dropped once their amount exceeds
+ * TrickyUtilities.TextMetricsCacheSize.
+ */
+class TRICKYUTILITIES_API FTrickyTextMetricsCache
+{
+public:
+	static FTrickyTextMetricsCache& Get();
+
+	/**
+	 * Returns the same size as UTextRenderComponent::GetTextLocalSize,
+	 * measuring the text only if it wasn't measured with the same font and scales before.
+	 */
+	FVector GetTextLocalSize(const UTextRenderComponent& Component);
+
+	/** Removes all stored sizes and resets the counters. Call it after font assets were changed. */
+	void Reset();
+
+	int32 Num() const { return Entries.Num(); }
+
+	int64 GetHitsAmount() const { return HitsAmount; }
+
+	int64 GetMissesAmount() const { return MissesAmount; }
+
+private:
+	struct FKey
+	{
+		FString Text;
+		TObjectKey<UFont> Font;
+		float WorldSize = 0.f;
+		float XScale = 0.f;
+		float YScale = 0.f;
+		float HorizSpacingAdjust = 0.f;
+		float VertSpacingAdjust = 0.f;
+
+		bool operator==(const FKey& Other) const;
+
+		friend uint32 GetTypeHash(const FKey& Key)
+		{
+			uint32 Hash = GetTypeHash(Key.Text);
+			Hash = HashCombine(Hash, GetTypeHash(Key.Font));
+			Hash = HashCombine(Hash, GetTypeHash(Key.WorldSize));
+			Hash = HashCombine(Hash, GetTypeHash(Key.XScale));
+			Hash = HashCombine(Hash, GetTypeHash(Key.YScale));
+			Hash = HashCombine(Hash, GetTypeHash(Key.HorizSpacingAdjust));
+			return HashCombine(Hash, GetTypeHash(Key.VertSpacingAdjust));
+		}
+	};
+
+	TMap<FKey, FVector> Entries;
+
+	int64 HitsAmount = 0;
+
+	int64 MissesAmount = 0;
+};
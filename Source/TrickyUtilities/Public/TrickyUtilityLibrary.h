@@ -3,9 +3,12 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Engine/LatentActionManager.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "TrickyUtilityLibrary.generated.h"
 
+struct FTrickyPatternBuffer;
 class USplineComponent;
 class UTimelineComponent;
 
@@ -20,7 +23,7 @@ enum class EStringTimeFormat : uint8
 	SS UMETA(DisplayName="SS")
 };
 
-UENUM()
+UENUM(BlueprintType)
 enum class EPointDirection : uint8
 {
 	Origin UMETA(DisplayName="Origin"),
@@ -30,6 +33,278 @@ enum class EPointDirection : uint8
 	Outside UMETA(DisplayName="Outside")
 };
 
+UENUM(BlueprintType)
+enum class EPatternType : uint8
+{
+	Grid UMETA(DisplayName="Grid"),
+	Cube UMETA(DisplayName="Cube"),
+	Ring UMETA(DisplayName="Ring"),
+	ConcentricRings UMETA(DisplayName="ConcentricRings"),
+	DynamicConcentricRings UMETA(DisplayName="DynamicConcentricRings"),
+	Cylinder UMETA(DisplayName="Cylinder"),
+	Arc UMETA(DisplayName="Arc"),
+	ConcentricArcs UMETA(DisplayName="ConcentricArcs"),
+	DynamicConcentricArcs UMETA(DisplayName="DynamicConcentricArcs"),
+	ArcCylinder UMETA(DisplayName="ArcCylinder"),
+	Sphere UMETA(DisplayName="Sphere"),
+	SunFlower UMETA(DisplayName="SunFlower")
+};
+
+/**
+ * Parameters of any pattern generator of UTrickyUtilityLibrary.
+ * Only the parameters used by the chosen PatternType are taken into account.
+ */
+USTRUCT(BlueprintType)
+struct TRICKYUTILITIES_API FTrickyPatternSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Pattern")
+	EPatternType PatternType = EPatternType::Ring;
+
+	/**
+	 * The number of cells along the X, Y and Z axes. Grid uses only X and Y.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category="Pattern",
+		meta=(ClampMin=1, UIMin=1,
+			EditCondition="PatternType==EPatternType::Grid||PatternType==EPatternType::Cube",
+			EditConditionHides))
+	FIntVector GridSize = FIntVector(4, 4, 4);
+
+	/**
+	 * The dimensions of each cell. Grid uses only X and Y.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category="Pattern",
+		meta=(EditCondition="PatternType==EPatternType::Grid||PatternType==EPatternType::Cube", EditConditionHides))
+	FVector CellSize = FVector(100.f);
+
+	/**
+	 * The number of points in the pattern or in each ring/arc of it.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category="Pattern",
+		meta=(ClampMin=1, UIMin=1,
+			EditCondition=
+			"PatternType!=EPatternType::Grid&&PatternType!=EPatternType::Cube&&PatternType!=EPatternType::DynamicConcentricRings&&PatternType!=EPatternType::DynamicConcentricArcs",
+			EditConditionHides))
+	int32 PointsAmount = 8;
+
+	/**
+	 * The number of rings or arcs.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category="Pattern",
+		meta=(ClampMin=1, UIMin=1,
+			EditCondition=
+			"PatternType==EPatternType::ConcentricRings||PatternType==EPatternType::DynamicConcentricRings||PatternType==EPatternType::Cylinder||PatternType==EPatternType::ConcentricArcs||PatternType==EPatternType::DynamicConcentricArcs||PatternType==EPatternType::ArcCylinder",
+			EditConditionHides))
+	int32 RingsAmount = 3;
+
+	/**
+	 * The minimum number of points per ring or arc.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category="Pattern",
+		meta=(ClampMin=1, UIMin=1,
+			EditCondition=
+			"PatternType==EPatternType::DynamicConcentricRings||PatternType==EPatternType::DynamicConcentricArcs",
+			EditConditionHides))
+	int32 MinPoints = 4;
+
+	/**
+	 * The maximum number of points per ring or arc.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category="Pattern",
+		meta=(ClampMin=1, UIMin=1,
+			EditCondition=
+			"PatternType==EPatternType::DynamicConcentricRings||PatternType==EPatternType::DynamicConcentricArcs",
+			EditConditionHides))
+	int32 MaxPoints = 16;
+
+	/**
+	 * The radius of the pattern.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category="Pattern",
+		meta=(ClampMin=0, UIMin=0,
+			EditCondition=
+			"PatternType==EPatternType::Ring||PatternType==EPatternType::Cylinder||PatternType==EPatternType::Arc||PatternType==EPatternType::ArcCylinder||PatternType==EPatternType::Sphere||PatternType==EPatternType::SunFlower",
+			EditConditionHides))
+	float Radius = 200.f;
+
+	/**
+	 * The radius of the innermost ring or arc.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category="Pattern",
+		meta=(ClampMin=0, UIMin=0,
+			EditCondition=
+			"PatternType==EPatternType::ConcentricRings||PatternType==EPatternType::DynamicConcentricRings||PatternType==EPatternType::ConcentricArcs||PatternType==EPatternType::DynamicConcentricArcs",
+			EditConditionHides))
+	float MinRadius = 100.f;
+
+	/**
+	 * The radius of the outermost ring or arc.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category="Pattern",
+		meta=(ClampMin=0, UIMin=0,
+			EditCondition=
+			"PatternType==EPatternType::ConcentricRings||PatternType==EPatternType::DynamicConcentricRings||PatternType==EPatternType::ConcentricArcs||PatternType==EPatternType::DynamicConcentricArcs",
+			EditConditionHides))
+	float MaxRadius = 300.f;
+
+	/**
+	 * The height of the cylinder patterns.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category="Pattern",
+		meta=(ClampMin=0, UIMin=0,
+			EditCondition="PatternType==EPatternType::Cylinder||PatternType==EPatternType::ArcCylinder",
+			EditConditionHides))
+	float Height = 200.f;
+
+	/**
+	 * The rotational offset applied to each ring in degrees.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category="Pattern",
+		meta=(EditCondition=
+			"PatternType==EPatternType::ConcentricRings||PatternType==EPatternType::DynamicConcentricRings||PatternType==EPatternType::Cylinder",
+			EditConditionHides))
+	float RingDeltaAngle = 0.f;
+
+	/**
+	 * The total angle of the arc patterns in degrees.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category="Pattern",
+		meta=(ClampMin=0, UIMin=0,
+			EditCondition=
+			"PatternType==EPatternType::Arc||PatternType==EPatternType::ConcentricArcs||PatternType==EPatternType::DynamicConcentricArcs||PatternType==EPatternType::ArcCylinder",
+			EditConditionHides))
+	float AngleDeg = 90.f;
+
+	/**
+	 * The minimum and maximum latitude of the sphere, normalized between -1 and 1.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category="Pattern",
+		meta=(EditCondition="PatternType==EPatternType::Sphere", EditConditionHides))
+	FVector2D Latitude = FVector2D(0.f, 1.f);
+
+	/**
+	 * The minimum and maximum longitude of the sphere, normalized between 0 and 1.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category="Pattern",
+		meta=(EditCondition="PatternType==EPatternType::Sphere", EditConditionHides))
+	FVector2D Longitude = FVector2D(0.f, 1.f);
+
+	/**
+	 * Specifies the orientation of each point relative to the origin.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category="Pattern",
+		meta=(EditCondition="PatternType!=EPatternType::Grid&&PatternType!=EPatternType::Cube", EditConditionHides))
+	EPointDirection Direction = EPointDirection::Outside;
+
+	bool operator==(const FTrickyPatternSettings& Other) const;
+
+	bool operator!=(const FTrickyPatternSettings& Other) const { return !(*this == Other); }
+
+	friend uint32 GetTypeHash(const FTrickyPatternSettings& Settings)
+	{
+		uint32 Hash = GetTypeHash(Settings.PatternType);
+		Hash = HashCombine(Hash, GetTypeHash(Settings.GridSize));
+		Hash = HashCombine(Hash, GetFloatHash(Settings.CellSize.X));
+		Hash = HashCombine(Hash, GetFloatHash(Settings.CellSize.Y));
+		Hash = HashCombine(Hash, GetFloatHash(Settings.CellSize.Z));
+		Hash = HashCombine(Hash, GetTypeHash(Settings.PointsAmount));
+		Hash = HashCombine(Hash, GetTypeHash(Settings.RingsAmount));
+		Hash = HashCombine(Hash, GetTypeHash(Settings.MinPoints));
+		Hash = HashCombine(Hash, GetTypeHash(Settings.MaxPoints));
+		Hash = HashCombine(Hash, GetFloatHash(Settings.Radius));
+		Hash = HashCombine(Hash, GetFloatHash(Settings.MinRadius));
+		Hash = HashCombine(Hash, GetFloatHash(Settings.MaxRadius));
+		Hash = HashCombine(Hash, GetFloatHash(Settings.Height));
+		Hash = HashCombine(Hash, GetFloatHash(Settings.RingDeltaAngle));
+		Hash = HashCombine(Hash, GetFloatHash(Settings.AngleDeg));
+		Hash = HashCombine(Hash, GetFloatHash(Settings.Latitude));
+		Hash = HashCombine(Hash, GetFloatHash(Settings.Longitude));
+		return HashCombine(Hash, GetTypeHash(Settings.Direction));
+	}
+
+private:
+	/** Hashes the value which operator== compares, so -0 and +0 get the same hash as they're equal. */
+	template <typename FloatType>
+	static uint32 GetFloatHash(const FloatType Value)
+	{
+		return GetTypeHash(Value == 0 ? FloatType(0) : Value);
+	}
+};
+
+UENUM(BlueprintType)
+enum class ESplineSamplingMode : uint8
+{
+	ByPoints UMETA(DisplayName="ByPoints"),
+	ByDistance UMETA(DisplayName="ByDistance")
+};
+
+/**
+ * Parameters of sampling a single spline in a batch.
+ */
+USTRUCT(BlueprintType)
+struct TRICKYUTILITIES_API FTrickySplineSamplingSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="SplineSampling")
+	ESplineSamplingMode SamplingMode = ESplineSamplingMode::ByPoints;
+
+	/**
+	 * The number of points to place along the spline.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category="SplineSampling",
+		meta=(ClampMin=1, UIMin=1, EditCondition="SamplingMode==ESplineSamplingMode::ByPoints", EditConditionHides))
+	int32 PointsAmount = 10;
+
+	/**
+	 * The distance interval between points along the spline.
+	 */
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category="SplineSampling",
+		meta=(ClampMin=0, UIMin=0, EditCondition="SamplingMode==ESplineSamplingMode::ByDistance", EditConditionHides))
+	float Distance = 100.f;
+
+	/**
+	 * If true, local space will be used to get transforms, otherwise world space.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="SplineSampling")
+	bool bUseLocalSpace = false;
+};
+
 /**
  * 
  */
@@ -60,6 +335,7 @@ public:
 
 	/**
 	 * Calculates a grid of transforms based on an origin transform, grid size, and cell size.
+	 * Big grids are filled on worker threads, see TrickyUtilities.ParallelPatternThreshold.
 	 *
 	 * @param Origin The transform used as the starting point and reference coordinate for the grid.
 	 * @param SizeX The number of cells along the X-axis. Must be greater than 0.
@@ -76,6 +352,7 @@ public:
 
 	/**
 	 * Calculates a series of transforms that form a 3D grid (cube) based on the specified origin, size, and cell dimensions.
+	 * Big cubes are filled on worker threads, see TrickyUtilities.ParallelPatternThreshold.
 	 *
 	 * @param Origin The transform that serves as the origin and basis for all calculated cell transforms.
 	 * @param SizeX The number of cells along the X-axis. Must be greater than 0.
@@ -306,6 +583,63 @@ public:
 	                                         const EPointDirection Direction,
 	                                         TArray<FTransform>& OutTransforms);
 
+	/**
+	 * Calculates transforms of a pattern described by the given settings.
+	 *
+	 * @param Origin Centre of the pattern.
+	 * @param Settings Pattern type and parameters of its generator.
+	 * @param OutTransforms An array that will store the resulting transforms.
+	 */
+	UFUNCTION(BlueprintCallable, Category="TrickyUtilities")
+	static void CalculatePatternTransforms(const FTransform& Origin,
+	                                       const FTrickyPatternSettings& Settings,
+	                                       TArray<FTransform>& OutTransforms);
+
+	/**
+	 * Calculates transforms of a pattern described by the given settings using the process wide pattern cache.
+	 * The local space pattern is generated once per settings and then only moved to the origin,
+	 * which gives the same result as CalculatePatternTransforms for origins with a unit scale.
+	 * With other scales the whole cached pattern is scaled, while CalculatePatternTransforms adds the cell offsets
+	 * of Grid and Cube patterns unscaled, so their spacing differs.
+	 *
+	 * @param Origin Centre of the pattern.
+	 * @param Settings Pattern type and parameters of its generator.
+	 * @param OutTransforms An array that will store the resulting transforms.
+	 */
+	UFUNCTION(BlueprintCallable, Category="TrickyUtilities")
+	static void CalculateCachedPatternTransforms(const FTransform& Origin,
+	                                             const FTrickyPatternSettings& Settings,
+	                                             TArray<FTransform>& OutTransforms);
+
+	/**
+	 * Calculates the same pattern around every given origin.
+	 * The local space pattern is taken from the pattern cache once and then moved to all origins on worker threads.
+	 * Transforms of all origins are written into one array one after another.
+	 *
+	 * @param Origins Centres of the patterns.
+	 * @param Settings Pattern type and parameters of its generator.
+	 * @param OutTransforms An array that will store the resulting transforms.
+	 * @param OutOffsets An array that will store the index of the first transform of every origin in OutTransforms.
+	 */
+	UFUNCTION(BlueprintCallable, Category="TrickyUtilities")
+	static void CalculatePatternTransformsForOrigins(const TArray<FTransform>& Origins,
+	                                                 const FTrickyPatternSettings& Settings,
+	                                                 TArray<FTransform>& OutTransforms,
+	                                                 TArray<int32>& OutOffsets);
+
+	/**
+	 * Moves a pattern calculated in local space to the given origin.
+	 * It's considerably cheaper than calculating the pattern again, as every point costs one transform multiplication.
+	 *
+	 * @param LocalTransforms Transforms of the pattern calculated with an identity origin.
+	 * @param Origin New centre of the pattern.
+	 * @param OutTransforms An array that will store the resulting transforms.
+	 */
+	UFUNCTION(BlueprintCallable, Category="TrickyUtilities")
+	static void RebasePatternTransforms(const TArray<FTransform>& LocalTransforms,
+	                                    const FTransform& Origin,
+	                                    TArray<FTransform>& OutTransforms);
+
 	/**
 	 * Retrieves transforms evenly distributed along a given spline based on the number of specified points.
 	 *
@@ -362,9 +696,244 @@ public:
 	                                              const bool bUseLocalSpace,
 	                                              TArray<FVector>& OutLocations);
 
-private:
-	static void CalculatePointRotation(const FTransform& Origin,
-	                                   const FTransform& Point,
+	/**
+	 * Retrieves transforms along a spline spaced by its curvature.
+	 * Samples are placed so the spline direction turns by no more than MaxAngle between two neighbouring ones,
+	 * which gives sparse samples on straight parts and dense ones in bends. Both ends of the spline are included.
+	 *
+	 * @param SplineComponent Pointer to a USplineComponent. Must be a valid instance.
+	 * @param MinDistance The minimal distance between points along the spline.
+	 * Must not be less than a millionth of the spline length.
+	 * @param MaxDistance The maximal distance between points along the spline. Must not be less than MinDistance.
+	 * @param MaxAngle The maximal turn of the spline direction between two points in degrees. Must be greater than 0.
+	 * @param bUseLocalSpace If true, local space will be used to get transforms, otherwise world space.
+	 * @param OutTransforms An array that will store the resulting transforms.
+	 */
+	UFUNCTION(BlueprintCallable, Category="TrickyUtilities")
+	static void GetTransformsAlongSplineByCurvature(USplineComponent* SplineComponent,
+	                                                const float MinDistance,
+	                                                const float MaxDistance,
+	                                                const float MaxAngle,
+	                                                const bool bUseLocalSpace,
+	                                                TArray<FTransform>& OutTransforms);
+
+	/**
+	 * Places a pattern along a spline at regular intervals, e.g. rings to build a tube.
+	 * The XY plane of the pattern is perpendicular to the spline and its Z axis points along the spline.
+	 * Frames are rotation minimizing, so the pattern doesn't twist around the spline on 3D curves.
+	 * The pattern is calculated once and the frames are stamped on worker threads.
+	 *
+	 * @param SplineComponent Pointer to a USplineComponent. Must be a valid instance.
+	 * @param Settings Pattern type and parameters of its generator.
+	 * @param Distance The maximal distance between two frames along the spline. Must be greater than 0.
+	 * @param bUseLocalSpace If true, local space will be used to get transforms, otherwise world space.
+	 * @param OutTransforms An array that will store the resulting transforms.
+	 */
+	UFUNCTION(BlueprintCallable, Category="TrickyUtilities")
+	static void SweepPatternAlongSpline(USplineComponent* SplineComponent,
+	                                    const FTrickyPatternSettings& Settings,
+	                                    const float Distance,
+	                                    const bool bUseLocalSpace,
+	                                    TArray<FTransform>& OutTransforms);
+
+	/**
+	 * Converts a spline into a polyline which deviates from it by no more than the given tolerance.
+	 * Every spline segment is subdivided only where it bends, so straight parts get no extra points.
+	 * Linear and constant segments are baked as straight lines between their points.
+	 *
+	 * @param SplineComponent Pointer to a USplineComponent. Must be a valid instance.
+	 * @param Tolerance Maximal distance between the spline and the polyline in the chosen space.
+	 * Must be greater than 0.
+	 * @param bUseLocalSpace If true, local space will be used to get locations, otherwise world space.
+	 * @param OutLocations An array that will store the points of the polyline.
+	 */
+	UFUNCTION(BlueprintCallable, Category="TrickyUtilities")
+	static void BakeSplineToPolyline(USplineComponent* SplineComponent,
+	                                 const float Tolerance,
+	                                 const bool bUseLocalSpace,
+	                                 TArray<FVector>& OutLocations);
+
+	/**
+	 * Samples transforms along many splines at once on worker threads.
+	 * Transforms of all splines are written into one array one after another.
+	 *
+	 * @param SplineComponents Splines to sample. Invalid splines get no transforms.
+	 * @param Settings Sampling settings of every spline. If it contains a single element, it's used for all splines.
+	 * @param OutTransforms An array that will store the resulting transforms.
+	 * @param OutOffsets An array that will store the index of the first transform of every spline in OutTransforms.
+	 */
+	UFUNCTION(BlueprintCallable, Category="TrickyUtilities")
+	static void GetTransformsAlongSplines(const TArray<USplineComponent*>& SplineComponents,
+	                                     const TArray<FTrickySplineSamplingSettings>& Settings,
+	                                     TArray<FTransform>& OutTransforms,
+	                                     TArray<int32>& OutOffsets);
+
+	/**
+	 * Same as GetTransformsAlongSplineByPoints, but the spline is sampled on a background task.
+	 * The output is filled when the node finishes.
+	 *
+	 * @param SplineComponent Pointer to a USplineComponent. Must be a valid instance.
+	 * @param PointsAmount The number of points to place along the spline. Must be greater than 0.
+	 * @param bUseLocalSpace If true, local space will be used to get transforms, otherwise world space.
+	 * @param OutTransforms An array that will store the resulting transforms.
+	 */
+	UFUNCTION(BlueprintCallable,
+		Category="TrickyUtilities",
+		meta=(Latent, LatentInfo="LatentInfo", WorldContext="WorldContextObject",
+			DisplayName="Get Transforms Along Spline By Points (Async)"))
+	static void AsyncGetTransformsAlongSplineByPoints(UObject* WorldContextObject,
+	                                                  USplineComponent* SplineComponent,
+	                                                  const int32 PointsAmount,
+	                                                  const bool bUseLocalSpace,
+	                                                  FLatentActionInfo LatentInfo,
+	                                                  TArray<FTransform>& OutTransforms);
+
+	/**
+	 * Same as GetTransformsAlongSplineByDistance, but the spline is sampled on a background task.
+	 * The output is filled when the node finishes.
+	 *
+	 * @param SplineComponent Pointer to a USplineComponent. Must be a valid instance.
+	 * @param Distance The distance interval between points along the spline. Must be greater than 0.
+	 * @param bUseLocalSpace If true, local space will be used to get transforms, otherwise world space.
+	 * @param OutTransforms An array that will store the resulting transforms.
+	 */
+	UFUNCTION(BlueprintCallable,
+		Category="TrickyUtilities",
+		meta=(Latent, LatentInfo="LatentInfo", WorldContext="WorldContextObject",
+			DisplayName="Get Transforms Along Spline By Distance (Async)"))
+	static void AsyncGetTransformsAlongSplineByDistance(UObject* WorldContextObject,
+	                                                    USplineComponent* SplineComponent,
+	                                                    const float Distance,
+	                                                    const bool bUseLocalSpace,
+	                                                    FLatentActionInfo LatentInfo,
+	                                                    TArray<FTransform>& OutTransforms);
+
+	/**
+	 * Same as GetTransformsAlongSplineByPoints, but the spline is sampled on a background task.
+	 * The spline curves are copied before the call returns, so the spline can be modified or destroyed right after it.
+	 */
+	static TFuture<TArray<FTransform>> GetTransformsAlongSplineByPointsAsync(USplineComponent* SplineComponent,
+	                                                                         const int32 PointsAmount,
+	                                                                         const bool bUseLocalSpace);
+
+	/**
+	 * Same as GetTransformsAlongSplineByDistance, but the spline is sampled on a background task.
+	 * The spline curves are copied before the call returns, so the spline can be modified or destroyed right after it.
+	 */
+	static TFuture<TArray<FTransform>> GetTransformsAlongSplineByDistanceAsync(USplineComponent* SplineComponent,
+	                                                                           const float Distance,
+	                                                                           const bool bUseLocalSpace);
+
+	/**
+	 * Native overloads of the pattern generators above.
+	 * Parameters match the Blueprint versions, but the points are appended to a structure of arrays buffer.
+	 */
+	static void CalculateGridTransforms(const FTransform& Origin,
+	                                    const int32 SizeX,
+	                                    const int32 SizeY,
+	                                    const FVector2D& CellSize,
+	                                    FTrickyPatternBuffer& OutBuffer);
+
+	static void CalculateCubeTransforms(const FTransform& Origin,
+	                                    const int32 SizeX,
+	                                    const int32 SizeY,
+	                                    const int32 SizeZ,
+	                                    const FVector& CellSize,
+	                                    FTrickyPatternBuffer& OutBuffer);
+
+	static void CalculateRingTransform(const FTransform& Origin,
+	                                   const int32 PointsAmount,
+	                                   const float Radius,
+	                                   const EPointDirection Direction,
+	                                   FTrickyPatternBuffer& OutBuffer);
+
+	static void CalculateConcentricRingsTransforms(const FTransform& Origin,
+	                                               const int32 RingsAmount,
+	                                               const int32 PointsPerRing,
+	                                               const float MinRadius,
+	                                               const float MaxRadius,
+	                                               const float RingDeltaAngle,
+	                                               const EPointDirection Direction,
+	                                               FTrickyPatternBuffer& OutBuffer);
+
+	static void CalculateDynamicConcentricRingsTransforms(const FTransform& Origin,
+	                                                      const int32 RingsAmount,
+	                                                      const int32 MinPoints,
+	                                                      const int32 MaxPoints,
+	                                                      const float MinRadius,
+	                                                      const float MaxRadius,
+	                                                      const float RingDeltaAngle,
+	                                                      const EPointDirection Direction,
+	                                                      FTrickyPatternBuffer& OutBuffer);
+
+	static void CalculateCylinderTransforms(const FTransform& Origin,
+	                                        const int32 RingsAmount,
+	                                        const int32 PointsPerRing,
+	                                        const float Radius,
+	                                        const float Height,
+	                                        const float RingDeltaAngle,
+	                                        const EPointDirection Direction,
+	                                        FTrickyPatternBuffer& OutBuffer);
+
+	static void CalculateArcTransforms(const FTransform& Origin,
+	                                   const int32 PointsAmount,
+	                                   const float Radius,
+	                                   const float AngleDeg,
 	                                   const EPointDirection Direction,
-	                                   FRotator& OutRotation);
+	                                   FTrickyPatternBuffer& OutBuffer);
+
+	static void CalculateConcentricArcsTransforms(const FTransform& Origin,
+	                                              const int32 ArcsAmount,
+	                                              const int32 PointsPerArc,
+	                                              const float MinRadius,
+	                                              const float MaxRadius,
+	                                              const float AngleDeg,
+	                                              const EPointDirection Direction,
+	                                              FTrickyPatternBuffer& OutBuffer);
+
+	static void CalculateDynamicConcentricArcsTransforms(const FTransform& Origin,
+	                                                     const int32 ArcsAmount,
+	                                                     const int32 MinPoints,
+	                                                     const int32 MaxPoints,
+	                                                     const float MinRadius,
+	                                                     const float MaxRadius,
+	                                                     const float AngleDeg,
+	                                                     const EPointDirection Direction,
+	                                                     FTrickyPatternBuffer& OutBuffer);
+
+	static void CalculateArcCylinderTransforms(const FTransform& Origin,
+	                                           const int32 ArcsAmount,
+	                                           const int32 PointsPerArc,
+	                                           const float Radius,
+	                                           const float Height,
+	                                           const float AngleDeg,
+	                                           const EPointDirection Direction,
+	                                           FTrickyPatternBuffer& OutBuffer);
+
+	static void CalculateSphereTransforms(const FTransform& Origin,
+	                                      const float Radius,
+	                                      const int32 PointsAmount,
+	                                      const float MinLatitude,
+	                                      const float MaxLatitude,
+	                                      const float MinLongitude,
+	                                      const float MaxLongitude,
+	                                      const EPointDirection Direction,
+	                                      FTrickyPatternBuffer& OutBuffer);
+
+	static void CalculateSunFlowerTransforms(const FTransform& Origin,
+	                                         const float Radius,
+	                                         const int32 PointsAmount,
+	                                         const EPointDirection Direction,
+	                                         FTrickyPatternBuffer& OutBuffer);
+
+	static void CalculatePatternTransforms(const FTransform& Origin,
+	                                       const FTrickyPatternSettings& Settings,
+	                                       FTrickyPatternBuffer& OutBuffer);
+
+	/**
+	 * Moves a local space pattern to the given origin in place.
+	 */
+	static void RebasePatternTransforms(TArray<FTransform>& InOutTransforms, const FTransform& Origin);
+
+	static void RebasePatternTransforms(FTrickyPatternBuffer& InOutBuffer, const FTransform& Origin);
 };